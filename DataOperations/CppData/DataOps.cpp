@@ -3,18 +3,17 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include "OutBuffer.h"
 
+/* formats all items, then writes them in one call */
 template <typename Coll>
 void show(const Coll& c, const std::string& msg = "") {
-  std::cout << "\n  ";
+  Utilities::OutBuffer out;
+  out << "\n  ";
   if(msg.length() > 0) {
-    std::cout << msg << " ";
-  }
-  using typename ValType = Coll::value_type;
-
-  for(ValType item : c) {
-    std::cout << item << " ";
+    out << msg << " ";
   }
+  out.putColl(c);
 }
 
 int main() {
@@ -14,59 +14,46 @@
     
       - High level part: Demo<T>
       - Low level parts: First, Second
-      - Abstraction defined in this package: 
-        - trait Say
+      - Abstraction defined in SayRegistry.h: 
+        - Say<D>
     The definitons of First and Second could be
     changed in any way that is compatible with 
-    trait Say without affecting compilation of
+    Say without affecting compilation of
     Demo<T>.
+
+    A host that doesn't know its components until
+    run time chooses them by kind from a registry
+    listing them at compile time, and keeps many
+    of them in contiguous storage, a SayStore.
+
+    Files Required:
+    ---------------
+    BasicDIP.cpp, SayRegistry.h
 */
 #include <iostream>
-using Byte = unsigned short;
-
-struct Say {
-    static Say create();
-    void set_id(Byte id);
-    void say();
-};
+#include "SayRegistry.h"
 
-class First : public Say {
+class First : public Say<First> {
 public:
-    First() : id_(0) {}
-    Say create() {
-        return First();
-    }
-    void set_id(Byte id)
-    {
-        id_ = id;
-    }
+    static constexpr std::string_view name = "First";
     void say() {
         std::cout << "\n  First here with id = " << id_;
     }
-private: 
-    Byte id_;
 };
 
-class Second : public Say {
+class Second : public Say<Second> {
 public:
-    Second() : id_(0) {}
-    Say create() {
-        return Second();
-    }
-    void set_id(Byte id)
-    {
-        id_ = id;
-    }
+    static constexpr std::string_view name = "Second";
     void say() {
         std::cout << "\n  Second here with id = " << id_;
     }
-private: 
-    Byte id_;
 };
 
 template<typename T>
+    requires SayComponent<T>
 class Demo {
 public:
+    Demo() : my_say(T::create()) {}
     void set_id(Byte id) {
         my_say.set_id(id);
     }
@@ -79,6 +66,9 @@ public:
 private:
     T my_say;
 };
+
+using Components = SayRegistry<First, Second>;
+
 int main() {
     std::cout << "\n  -- basic_dip demo --\n";
 
@@ -89,6 +79,29 @@ int main() {
     Demo<Second> demo2;
     demo2.set_id(2);
     demo2.say_it();
+    std::cout << "\n  demo2 id: " << demo2.get_id();
+    std::cout << "\n";
+
+    /*-- kinds chosen at run time, components stored by type --*/
+    SayStore<Components> store;
+    size_t kinds[] = { 1, 0, 1, 1, 0 };
+    Byte id = 10;
+    for(size_t kind : kinds)
+        store.add(kind, id++);
+    std::cout << "\n  kind of Second: " << Components::kind_of<Second>
+              << ", kind 0 is " << Components::name(0);
+    store.for_each([](auto& component) { component.say(); });
+    std::cout << "\n";
+
+    /*-- thousands, iterated in contiguous arrays --*/
+    SayStore<Components> many;
+    many.reserve(5000);
+    for(Byte i = 0; i < 10000; ++i)
+        many.add(i % Components::size, i);
+    size_t id_sum = 0;
+    many.for_each([&](auto& component) { id_sum += component.get_id(); });
+    std::cout << "\n  " << many.size() << " components, " << many.all<First>().size()
+              << " First, ids sum to " << id_sum;
 
-    std::cout << "\n  That's all Folks!\n\n";
-}
\ No newline at end of file
+    std::cout << "\n\n  That's all Folks!\n\n";
+}
@@ -0,0 +1,161 @@
+#pragma once
+/////////////////////////////////////////////////
+// SayRegistry.h                               //
+// - Say abstraction, with components listed   //
+//   and stored in bulk at compile time        //
+// Jim Fawcett, 17 Oct 2026                    //
+/////////////////////////////////////////////////
+/*
+    Say<D> is the abstraction Demo depends on.  It
+    is a CRTP base: each component D derives from
+    Say<D> and defines say(), and Say supplies
+    create, returning a D, and the id accessors.
+
+    SayRegistry<First, Second, ...> lists the
+    components a host knows, fixed at compile time.
+    A component's kind is its index in the list:
+
+      using Components = SayRegistry<First, Second>;
+      Components::kind_of<Second>     // 1
+      Components::name(1)             // "Second"
+      Components::visit(kind, f)      // f(Second{}) for kind 1
+
+    - visit indexes a constexpr table of function
+      pointers, one per component, so lookup by
+      kind needs no hashing and no allocation.
+    - SayStore<Components> keeps one std::vector
+      per component type, so many components sit
+      in contiguous arrays, and for_each calls say
+      and other members directly, without virtual
+      dispatch or pointer chasing.
+    - adding a component adds its type to the list,
+      with no change to Demo or to this file.
+*/
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using Byte = unsigned short;
+
+template<typename D>
+struct Say {
+    static D create() {
+        return D();
+    }
+    void set_id(Byte id) {
+        id_ = id;
+    }
+    Byte get_id() const {
+        return id_;
+    }
+protected:
+    Byte id_ = 0;
+};
+
+/*-- what Demo and the registry need of a component U --*/
+template<typename U>
+concept SayComponent = std::derived_from<U, Say<U>> &&
+    requires(U u, const U cu) {
+        { U::create() } -> std::same_as<U>;
+        { U::name } -> std::convertible_to<std::string_view>;
+        u.say();
+        { cu.get_id() } -> std::same_as<Byte>;
+    };
+
+/*-- components known to a host, each identified by its kind --*/
+template<SayComponent... Components>
+class SayRegistry {
+public:
+    static constexpr size_t size = sizeof...(Components);
+    static_assert(size > 0, "SayRegistry needs at least one component");
+
+    /* kind of U, a compile error if U isn't listed */
+    template<typename U>
+        requires (std::is_same_v<U, Components> || ...)
+    static constexpr size_t kind_of = [] {
+        constexpr bool matches[] = { std::is_same_v<U, Components>... };
+        size_t kind = 0;
+        while(kind < size && !matches[kind])
+            ++kind;
+        return kind;
+    }();
+
+    template<size_t Kind>
+    using type = std::tuple_element_t<Kind, std::tuple<Components...>>;
+
+    static constexpr bool contains(size_t kind) {
+        return kind < size;
+    }
+    static constexpr std::string_view name(size_t kind) {
+        constexpr std::array<std::string_view, size> names = { Components::name... };
+        return kind < size ? names[kind] : std::string_view();
+    }
+
+    /*-- f(U::create()) for the component U of kind --*/
+    template<typename F>
+    static void visit(size_t kind, F&& f) {
+        using entry = void (*)(F&);
+        constexpr std::array<entry, size> table = {
+            [](F& fn) { fn(Components::create()); }...
+        };
+        if(kind >= size)
+            throw std::invalid_argument("SayRegistry: no component of kind " + std::to_string(kind));
+        table[kind](f);
+    }
+};
+
+/*-- components of a registry, stored contiguously by type --*/
+template<typename Registry>
+class SayStore;
+
+template<SayComponent... Components>
+class SayStore<SayRegistry<Components...>> {
+public:
+    using registry = SayRegistry<Components...>;
+
+    template<typename U>
+    U& add(Byte id) {
+        U& u = std::get<std::vector<U>>(parts).emplace_back(U::create());
+        u.set_id(id);
+        return u;
+    }
+    /*-- add a component chosen at run time by kind --*/
+    void add(size_t kind, Byte id) {
+        registry::visit(kind, [&](auto u) {
+            u.set_id(id);
+            std::get<std::vector<decltype(u)>>(parts).push_back(u);
+        });
+    }
+    /* room for count components of each kind */
+    void reserve(size_t count) {
+        (std::get<std::vector<Components>>(parts).reserve(count), ...);
+    }
+
+    template<typename U>
+    std::vector<U>& all() {
+        return std::get<std::vector<U>>(parts);
+    }
+    size_t size() const {
+        return (std::get<std::vector<Components>>(parts).size() + ...);
+    }
+
+    /*-- f(u) for every component, type by type, in order of kind --*/
+    template<typename F>
+    void for_each(F&& f) {
+        (for_all(std::get<std::vector<Components>>(parts), f), ...);
+    }
+private:
+    template<typename U, typename F>
+    static void for_all(std::vector<U>& us, F& f) {
+        for(U& u : us)
+            f(u);
+    }
+    std::tuple<std::vector<Components>...> parts;
+};
@@ -0,0 +1,127 @@
+#pragma once
+/////////////////////////////////////////////////
+// CalcDispatch.h                              //
+// - choose Calc components by name at run     //
+//   time, paying for dispatch once per batch  //
+// Jim Fawcett, 17 Oct 2026                    //
+/////////////////////////////////////////////////
+/*
+    Demo<U, T> binds its component at compile time.
+    When the operation is only known at run time,
+    from configuration, a virtual Calc interface
+    costs an indirect call per element.  CalcTable
+    instead maps names to kernels, each a pointer
+    to a compiled calc_batch of one component, so
+    a batch costs one lookup and one indirect call:
+
+      CalcOp<double> op = calc_table<double>().find(name);
+      op.calc_batch(arg1, arg2, out);   // U::calc_batch, inlined loop
+
+    - calc_table<T>() is the table for T, holding
+      "plus" and "times" to start.
+    - add<U>(name) registers any CalcComponent U,
+      so new operations need no change to Demo or
+      to this file.  Adding a name again replaces
+      its kernel.
+    - find throws invalid_argument for an unknown
+      name.  CalcOps hold copies of the kernel
+      pointers, so are cheap to pass and keep.
+    - tables aren't locked, so add components
+      before threads use the table.
+*/
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "GenericCalc.h"
+
+/*-- one component's calc and calc_batch, chosen at run time --*/
+template<typename T>
+class CalcOp {
+public:
+    using value_type = T;
+    using calc_fn = T (*)(T, T);
+    using batch_fn = void (*)(std::span<const T>, std::span<const T>, std::span<T>);
+
+    CalcOp(calc_fn calc, batch_fn batch) : calc_(calc), batch_(batch) {}
+
+    T calc(T arg1, T arg2) const {
+        return calc_(arg1, arg2);
+    }
+    /*-- out[i] = calc(arg1[i], arg2[i]), one indirect call per batch --*/
+    void calc_batch(
+        std::span<const T> arg1, std::span<const T> arg2, std::span<T> out
+    ) const {
+        batch_(arg1, arg2, out);
+    }
+private:
+    calc_fn calc_;
+    batch_fn batch_;
+};
+
+/*-- kernels for component U, compiled where U is registered --*/
+template<typename U, typename T>
+    requires CalcComponent<U, T>
+CalcOp<T> calc_op() {
+    return CalcOp<T>(
+        [](T arg1, T arg2) { return U::create().calc(arg1, arg2); },
+        [](std::span<const T> arg1, std::span<const T> arg2, std::span<T> out) {
+            U::create().calc_batch(arg1, arg2, out);
+        }
+    );
+}
+
+/*-- names of operations and their kernels --*/
+template<typename T>
+class CalcTable {
+public:
+    template<typename U>
+        requires CalcComponent<U, T>
+    void add(std::string_view name) {
+        for(auto& entry : entries)
+            if(entry.name == name) {
+                entry.op = calc_op<U, T>();
+                return;
+            }
+        entries.push_back(Entry{ std::string(name), calc_op<U, T>() });
+    }
+    /* a few names, so a linear search beats hashing */
+    CalcOp<T> find(std::string_view name) const {
+        for(auto& entry : entries)
+            if(entry.name == name)
+                return entry.op;
+        throw std::invalid_argument("CalcTable: no operation named " + std::string(name));
+    }
+    bool contains(std::string_view name) const {
+        for(auto& entry : entries)
+            if(entry.name == name)
+                return true;
+        return false;
+    }
+    std::vector<std::string> names() const {
+        std::vector<std::string> result;
+        for(auto& entry : entries)
+            result.push_back(entry.name);
+        return result;
+    }
+private:
+    struct Entry {
+        std::string name;
+        CalcOp<T> op;
+    };
+    std::vector<Entry> entries;
+};
+
+/*-- the table for T, starting with plus and times --*/
+template<typename T>
+CalcTable<T>& calc_table() {
+    static CalcTable<T> table = [] {
+        CalcTable<T> t;
+        t.template add<Plus<T>>("plus");
+        t.template add<Times<T>>("times");
+        return t;
+    }();
+    return table;
+}
@@ -0,0 +1,139 @@
+#pragma once
+/////////////////////////////////////////////////
+// CalcExpr.h                                  //
+// - fuse compositions of Calc components      //
+//   into one loop                             //
+// Jim Fawcett, 17 Oct 2026                    //
+/////////////////////////////////////////////////
+/*
+    Computing (a + b) * c with calc_batch takes
+    two passes and a temporary array for a + b.
+    Expression templates record the composition
+    as a type instead, and evaluate computes it
+    one element at a time, in a single loop with
+    no intermediate arrays:
+
+      auto expr = (calc_arg(a) + calc_arg(b)) * calc_arg(c);
+      evaluate(expr, out);     // out[i] = (a[i] + b[i]) * c[i]
+
+    - calc_arg(x) wraps a contiguous array of T,
+      calc_scalar(v) a value used at every index.
+    - + and * compose with Plus and Times, and
+      calc_apply(oper, lhs, rhs) with any other
+      CalcComponent, like those of GenericCalc.h.
+    - concept CalcExpression checks, at compile
+      time, that operands share a value type and
+      that oper is a CalcComponent for it.
+    - arrays are referenced, not copied, so must
+      outlive the expression.  Composing arrays
+      of different sizes throws invalid_argument,
+      as does evaluating only scalars to a vector.
+*/
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "GenericCalc.h"
+
+/* size of scalars, which match any size */
+inline constexpr size_t calc_any_size = std::numeric_limits<size_t>::max();
+
+/*-- an expression: element i of its value_type, over size() elements --*/
+template<typename E>
+concept CalcExpression = requires(const E e, size_t i) {
+    typename E::calc_expression_tag;   // so containers aren't expressions
+    typename E::value_type;
+    { e[i] } -> std::convertible_to<typename E::value_type>;
+    { e.size() } -> std::convertible_to<size_t>;
+};
+
+/*-- elements of an array --*/
+template<typename T>
+struct CalcArg {
+    using calc_expression_tag = void;
+    using value_type = T;
+    std::span<const T> data;
+    T operator[](size_t i) const { return data[i]; }
+    size_t size() const { return data.size(); }
+};
+
+/*-- one value, at every index --*/
+template<typename T>
+struct CalcScalar {
+    using calc_expression_tag = void;
+    using value_type = T;
+    T value;
+    T operator[](size_t) const { return value; }
+    size_t size() const { return calc_any_size; }
+};
+
+/*-- oper.calc of corresponding elements of lhs and rhs --*/
+template<typename Oper, CalcExpression L, CalcExpression R>
+    requires std::same_as<typename L::value_type, typename R::value_type>
+          && CalcComponent<Oper, typename L::value_type>
+struct CalcBinary {
+    using calc_expression_tag = void;
+    using value_type = typename L::value_type;
+    Oper oper;
+    L lhs;
+    R rhs;
+    value_type operator[](size_t i) const {
+        return oper.calc(lhs[i], rhs[i]);
+    }
+    /* scalars have calc_any_size, so the smaller is the array's */
+    size_t size() const {
+        return lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+    }
+};
+
+template<typename T>
+CalcArg<T> calc_arg(std::span<const T> data) {
+    return CalcArg<T>{ data };
+}
+template<typename T>
+CalcArg<T> calc_arg(const std::vector<T>& data) {
+    return CalcArg<T>{ std::span<const T>(data) };
+}
+template<typename T>
+CalcScalar<T> calc_scalar(T value) {
+    return CalcScalar<T>{ value };
+}
+
+/*-- compose with any Calc component, arrays must match in size --*/
+template<typename Oper, CalcExpression L, CalcExpression R>
+auto calc_apply(Oper oper, L lhs, R rhs) {
+    if(lhs.size() != rhs.size() && lhs.size() != calc_any_size && rhs.size() != calc_any_size)
+        throw std::invalid_argument("calc_apply: operands differ in size");
+    return CalcBinary<Oper, L, R>{ oper, lhs, rhs };
+}
+
+template<CalcExpression L, CalcExpression R>
+auto operator+(L lhs, R rhs) {
+    return calc_apply(Plus<typename L::value_type>::create(), lhs, rhs);
+}
+template<CalcExpression L, CalcExpression R>
+auto operator*(L lhs, R rhs) {
+    return calc_apply(Times<typename L::value_type>::create(), lhs, rhs);
+}
+
+/*-- out[i] = expr[i], for each i, in one loop --*/
+template<CalcExpression E>
+void evaluate(const E& expr, std::span<typename E::value_type> out) {
+    size_t n = expr.size();
+    if(n != out.size() && n != calc_any_size)
+        throw std::invalid_argument("evaluate: expression and out differ in size");
+    for(size_t i = 0; i < out.size(); ++i)
+        out[i] = expr[i];
+}
+
+/*-- expr's elements in a new vector, expr needs an array operand --*/
+template<CalcExpression E>
+std::vector<typename E::value_type> evaluate(const E& expr) {
+    if(expr.size() == calc_any_size)
+        throw std::invalid_argument("evaluate: expression has no array operand to size it");
+    std::vector<typename E::value_type> out(expr.size());
+    evaluate(expr, std::span<typename E::value_type>(out));
+    return out;
+}
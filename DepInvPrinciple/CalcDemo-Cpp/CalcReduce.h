@@ -0,0 +1,149 @@
+#pragma once
+/////////////////////////////////////////////////
+// CalcReduce.h                                //
+// - fold large arrays with a Calc component   //
+//   on all cores                              //
+// Jim Fawcett, 17 Oct 2026                    //
+/////////////////////////////////////////////////
+/*
+    calc_reduce folds args with an associative
+    component, like Plus for sums and Times for
+    products, starting from identity, which must
+    leave values unchanged, like 0 for Plus:
+
+      double sum = calc_reduce(Plus<double>::create(), args, 0.0);
+
+    args are cut into blocks of 4096, and threads
+    each fold a contiguous run of blocks, the
+    calling thread too.  Within a block, eight
+    accumulators each fold a contiguous eighth,
+    in step, so the loop isn't held up waiting on
+    each calc.  Values are only ever combined with
+    their neighbors, in order, so oper needn't be
+    commutative, like concatenation.
+
+    - calc_order::fast folds each thread's blocks
+      into its own accumulator, padded to a cache
+      line so threads don't slow each other with
+      false sharing, then folds those in thread
+      order.  Floating point results can change,
+      slightly, with the number of threads.
+    - calc_order::deterministic keeps each block's
+      result and combines them pairwise in a fixed
+      tree that depends only on args.size(), so
+      results are the same for any thread count.
+    - threads = 0 uses one per core.  Exceptions
+      thrown by calc are rethrown to the caller.
+*/
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <span>
+#include <thread>
+#include <vector>
+#include "GenericCalc.h"
+
+enum class calc_order { fast, deterministic };
+
+/* a value alone on its cache line */
+template<typename T>
+struct alignas(64) calc_padded {
+    T value;
+};
+
+namespace calc_detail {
+    constexpr size_t block = 4096;
+    constexpr size_t lanes = 8;
+
+    /*-- fold n values with lanes accumulators, each over a contiguous run --*/
+    template<typename U, typename T>
+    T fold(const U& oper, const T* args, size_t n, T identity) {
+        T acc[lanes];
+        std::fill(acc, acc + lanes, identity);
+        size_t run = n / lanes;
+        for(size_t i = 0; i < run; ++i)
+            for(size_t k = 0; k < lanes; ++k)
+                acc[k] = oper.calc(acc[k], args[k * run + i]);
+        /* the tail follows the last lane's run */
+        for(size_t i = lanes * run; i < n; ++i)
+            acc[lanes - 1] = oper.calc(acc[lanes - 1], args[i]);
+        /* combine neighbors, in order, halving the lanes each pass */
+        for(size_t width = lanes / 2; width > 0; width /= 2)
+            for(size_t k = 0; k < width; ++k)
+                acc[k] = oper.calc(acc[2 * k], acc[2 * k + 1]);
+        return acc[0];
+    }
+
+    /*-- run task(w, first, last) for each thread's run of blocks --*/
+    template<typename Task>
+    void run_threads(size_t threads, size_t blocks, Task task) {
+        std::vector<std::exception_ptr> errors(threads);
+        auto work = [&](size_t w) {
+            try {
+                task(w, blocks * w / threads, blocks * (w + 1) / threads);
+            }
+            catch(...) {
+                errors[w] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> workers;
+        for(size_t w = 1; w < threads; ++w)
+            workers.emplace_back(work, w);
+        work(0);
+        for(auto& t : workers)
+            t.join();
+        for(auto& error : errors)
+            if(error)
+                std::rethrow_exception(error);
+    }
+}
+
+/*-- fold args with oper, starting from identity, on threads threads --*/
+template<typename U>
+    requires CalcComponent<U, typename U::value_type>
+typename U::value_type calc_reduce(
+    const U& oper,
+    std::span<const typename U::value_type> args,
+    typename U::value_type identity,
+    calc_order order = calc_order::fast,
+    size_t threads = 0
+) {
+    using T = typename U::value_type;
+    using calc_detail::block;
+    size_t blocks = (args.size() + block - 1) / block;
+    if(threads == 0)
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    threads = std::max<size_t>(1, std::min(threads, blocks));
+    auto fold_block = [&](size_t b) {
+        size_t first = b * block;
+        return calc_detail::fold(
+            oper, args.data() + first, std::min(block, args.size() - first), identity
+        );
+    };
+
+    if(order == calc_order::fast) {
+        std::vector<calc_padded<T>> partials(threads, calc_padded<T>{ identity });
+        calc_detail::run_threads(threads, blocks, [&](size_t w, size_t first, size_t last) {
+            for(size_t b = first; b < last; ++b)
+                partials[w].value = oper.calc(partials[w].value, fold_block(b));
+        });
+        T result = identity;
+        for(auto& partial : partials)
+            result = oper.calc(result, partial.value);
+        return result;
+    }
+
+    /* threads write each block's result once, so sharing lines costs little */
+    std::vector<T> results(blocks, identity);
+    calc_detail::run_threads(threads, blocks, [&](size_t, size_t first, size_t last) {
+        for(size_t b = first; b < last; ++b)
+            results[b] = fold_block(b);
+    });
+    for(size_t n = blocks; n > 1; n = (n + 1) / 2) {
+        for(size_t k = 0; k < n / 2; ++k)
+            results[k] = oper.calc(results[2 * k], results[2 * k + 1]);
+        if(n % 2 == 1)
+            results[n / 2] = results[n - 1];
+    }
+    return blocks == 0 ? identity : results[0];
+}
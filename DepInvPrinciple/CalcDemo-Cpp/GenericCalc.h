@@ -0,0 +1,93 @@
+#pragma once
+/////////////////////////////////////////////////
+// GenericCalc.h                               //
+// - Calc abstraction and its components for   //
+//   GenericDIP.cpp                            //
+// Jim Fawcett, 17 Oct 2026                    //
+/////////////////////////////////////////////////
+/*
+    Calc<D, T> is the abstraction Demo depends on.
+    It is a CRTP base: each component D derives
+    from Calc<D, T> and defines calc(arg1, arg2),
+    and Calc supplies calc_batch, applying D's calc
+    to whole spans of arguments.
+
+    Demo<U, T> holds its component by value, and
+    the concept CalcComponent checks, at compile
+    time, that U has what Demo uses, so calls are
+    bound at compile time, with no heap allocation
+    or virtual dispatch.  Components could still
+    change in any way compatible with Calc without
+    affecting Demo.
+
+    calc_batch's loop calls D::calc inline, so the
+    compiler can vectorize it.
+*/
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+
+template<typename D, typename T>
+struct Calc {
+    using value_type = T;
+
+    /*-- out[i] = calc(arg1[i], arg2[i]) for each i --*/
+    void calc_batch(
+        std::span<const T> arg1, std::span<const T> arg2, std::span<T> out
+    ) const {
+        if(arg1.size() != out.size() || arg2.size() != out.size())
+            throw std::invalid_argument("calc_batch: spans differ in size");
+        const D& oper = static_cast<const D&>(*this);
+        if(overlaps(arg1, out) || overlaps(arg2, out)) {
+            for(size_t i = 0; i < out.size(); ++i)
+                out[i] = oper.calc(arg1[i], arg2[i]);
+        }
+        else
+            apply(oper, arg1.data(), arg2.data(), out.data(), out.size());
+    }
+private:
+    /* std::less orders any pointers, built-in < only those into one array */
+    static bool overlaps(std::span<const T> in, std::span<T> out) {
+        std::less<const T*> before;
+        const T* o = out.data();
+        return before(in.data(), o + out.size()) && before(o, in.data() + in.size());
+    }
+    /* restrict promises no overlap, so the loop vectorizes without checks */
+    static void apply(
+        const D& oper, const T* __restrict arg1, const T* __restrict arg2,
+        T* __restrict out, size_t n
+    ) {
+        for(size_t i = 0; i < n; ++i)
+            out[i] = oper.calc(arg1[i], arg2[i]);
+    }
+};
+
+template<typename T>
+struct Plus : Calc<Plus<T>, T> {
+    static Plus create() {
+        return Plus();
+    }
+    T calc(T arg1, T arg2) const {
+        return arg1 + arg2;
+    }
+};
+
+template<typename T>
+struct Times : Calc<Times<T>, T> {
+    static Times create() {
+        return Times();
+    }
+    T calc(T arg1, T arg2) const {
+        return arg1 * arg2;
+    }
+};
+
+/*-- what Demo needs of a component U for T --*/
+template<typename U, typename T>
+concept CalcComponent = std::derived_from<U, Calc<U, T>> &&
+    requires(const U u, T arg) {
+        { U::create() } -> std::same_as<U>;
+        { u.calc(arg, arg) } -> std::convertible_to<T>;
+    };
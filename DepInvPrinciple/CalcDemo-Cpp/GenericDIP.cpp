@@ -12,69 +12,97 @@
     This demonstration builds a basic demo with
     self-annunciating low level components.
     
-      - High level part: Demo<T>
-      - Low level parts: First, Second
-      - Abstraction defined in this package: 
-        - trait Say
-    The definitons of First and Second could be
+      - High level part: Demo<U, T>
+      - Low level parts: Plus, Times
+      - Abstraction defined in GenericCalc.h: 
+        - Calc<D, T>
+    The definitons of Plus and Times could be
     changed in any way that is compatible with 
-    trait Say without affecting compilation of
-    Demo<T>.
+    Calc without affecting compilation of
+    Demo<U, T>.
+
+    Compositions of components, like (a + b) * c,
+    are fused into one loop with the expression
+    templates of CalcExpr.h.  Larger, defined
+    here, composes with calc_apply just as Plus
+    and Times do with + and *.
+
+    Operations named at run time, here by the
+    first command line argument, are found in
+    the table of CalcDispatch.h, once per batch.
+    Larger is registered with the table in main.
+
+    Demo::do_reduce folds a whole array with its
+    component on all cores, using CalcReduce.h.
+
+    Files Required:
+    ---------------
+    GenericDIP.cpp, GenericCalc.h, CalcExpr.h,
+    CalcDispatch.h, CalcReduce.h
 */
 #include <iostream>
-#include <memory>
+#include <string>
+#include <vector>
+#include "GenericCalc.h"
+#include "CalcExpr.h"
+#include "CalcDispatch.h"
+#include "CalcReduce.h"
 using Byte = unsigned short;
 
-template<typename T>
-struct Calc {
-    static std::unique_ptr<Calc<T>> create();
-    T calc(T arg1, T arg2);
-};
-
-template<typename T>
-class Plus : public Calc<T> {
-public:
-    static std::unique_ptr<Calc<T>> create() {
-        return std::unique_ptr<Calc<T>>(new Plus);
+/*-- associative, but not commutative --*/
+struct Concat : Calc<Concat, std::string> {
+    static Concat create() {
+        return Concat();
     }
-    T calc(T arg1, T arg2)
-    {
+    std::string calc(const std::string& arg1, const std::string& arg2) const {
         return arg1 + arg2;
     }
 };
 
+/*-- a component defined by a user of Calc --*/
 template<typename T>
-class Times : public Calc<T> {
-public:
-    static std::unique_ptr<Calc<T>> create() {
-        return std::unique_ptr<Calc<T>>(new Times);
+struct Larger : Calc<Larger<T>, T> {
+    static Larger create() {
+        return Larger();
     }
-    T calc(T arg1, T arg2)
-    {
-        return arg1 * arg2;
+    T calc(T arg1, T arg2) const {
+        return arg1 < arg2 ? arg2 : arg1;
     }
 };
 
-
 template<typename U, typename T>
+    requires CalcComponent<U, T>
 class Demo {
 public:
-    Demo() {
-        std::unique_ptr<Calc<T>> oper = U::create();
-    }
+    Demo() : oper(U::create()) {}
     T do_calc(T arg1, T arg2) {
-        T rslt = oper->calc(arg1, arg2);
+        T rslt = oper.calc(arg1, arg2);
         result = rslt;
         return rslt;
     }
+    void do_calc_batch(
+        std::span<const T> arg1, std::span<const T> arg2, std::span<T> out
+    ) {
+        oper.calc_batch(arg1, arg2, out);
+        if(!out.empty())
+            result = out.back();
+    }
+    /* identity leaves values unchanged, like 0 for Plus */
+    T do_reduce(
+        std::span<const T> args, T identity,
+        calc_order order = calc_order::fast, size_t threads = 0
+    ) {
+        result = calc_reduce(oper, args, identity, order, threads);
+        return result;
+    }
     T get_result() {
         return result;
     }
 private:
-    std::unique_ptr<U> oper;
-    T result;
+    U oper;
+    T result{};
 };
-int main() {
+int main(int argc, char* argv[]) {
     std::cout << "\n  -- generic DIP demo --\n";
 
     Demo<Plus<int>, int> demo1;
@@ -87,6 +115,80 @@ int main() {
     double some_number = demo2.do_calc(42.5, 2.0);
     std::cout << "\n  some-number = " << some_number;
     std::cout << "\n  saved result: " << demo2.get_result();
+    std::cout << "\n";
+
+    std::vector<int> args1 { 1, 2, 3, 4, 5, 6, 7, 8 };
+    std::vector<int> args2 { 8, 7, 6, 5, 4, 3, 2, 1 };
+    std::vector<int> products(args1.size());
+    Demo<Times<int>, int> demo3;
+    demo3.do_calc_batch(args1, args2, products);
+    std::cout << "\n  batch products:";
+    for(int product : products)
+        std::cout << " " << product;
+    std::cout << "\n  saved result: " << demo3.get_result();
+    std::cout << "\n";
+
+    /*-- (args1 + args2) * args1, then larger of that and 20, in one loop --*/
+    auto expr = calc_apply(
+        Larger<int>::create(),
+        (calc_arg(args1) + calc_arg(args2)) * calc_arg(args1),
+        calc_scalar(20)
+    );
+    std::vector<int> fused = evaluate(expr);
+    std::cout << "\n  fused max((a + b) * a, 20):";
+    for(int value : fused)
+        std::cout << " " << value;
+    std::cout << "\n";
+
+    /*-- operation named at run time, resolved once for the batch --*/
+    calc_table<int>().add<Larger<int>>("larger");
+    std::string name = argc > 1 ? argv[1] : "larger";
+    try {
+        CalcOp<int> op = calc_table<int>().find(name);
+        std::vector<int> results(args1.size());
+        op.calc_batch(args1, args2, results);
+        std::cout << "\n  batch " << name << ":";
+        for(int value : results)
+            std::cout << " " << value;
+    }
+    catch(std::invalid_argument& ex) {
+        std::cout << "\n  " << ex.what() << ", try one of:";
+        for(auto& known : calc_table<int>().names())
+            std::cout << " " << known;
+    }
+    std::cout << "\n";
+
+    /*-- fold a million values on all cores --*/
+    std::vector<double> values(1'000'000);
+    for(size_t i = 0; i < values.size(); ++i)
+        values[i] = 1.0 / (i + 1);
+    Demo<Plus<double>, double> demo4;
+    std::cout.precision(17);
+    std::cout << "\n  harmonic sum, fast:          " << demo4.do_reduce(values, 0.0);
+    for(size_t threads : { 1, 3, 8 })
+        std::cout << "\n  deterministic, " << threads << " thread(s): "
+                  << demo4.do_reduce(values, 0.0, calc_order::deterministic, threads);
+    std::cout << "\n  saved result: " << demo4.get_result();
+    std::cout << "\n";
+
+    /*-- order is kept, so reduce matches a serial fold of Concat --*/
+    std::vector<std::string> letters;
+    for(char ch = 'a'; ch <= 't'; ++ch)
+        letters.push_back(std::string(1, ch));
+    Demo<Concat, std::string> demo5;
+    std::cout << "\n  concat a..t: " << demo5.do_reduce(letters, "");
+    std::vector<std::string> many(10'000);
+    std::string serial;
+    for(size_t i = 0; i < many.size(); ++i) {
+        many[i] = std::string(1, char('a' + i % 26));
+        serial += many[i];
+    }
+    for(calc_order order : { calc_order::fast, calc_order::deterministic })
+        for(size_t threads : { 1, 3 })
+            std::cout << "\n  concat of 10000, "
+                      << (order == calc_order::fast ? "fast, " : "deterministic, ")
+                      << threads << " thread(s), matches serial fold: " << std::boolalpha
+                      << (demo5.do_reduce(many, "", order, threads) == serial);
 
     std::cout << "\n\n  That's all Folks!\n\n";
 }
\ No newline at end of file
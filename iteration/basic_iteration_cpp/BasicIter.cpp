@@ -11,11 +11,20 @@
   A C++ iterator is a smart pointer associated 
   with some collection, e.g., std::string or 
   std::vector<T>.   
+
+  Files Required:
+  ---------------
+  BasicIter.cpp, ParallelChunks.h
+  OutBuffer.h (timers/Cpp/src)
 */
 #include<ranges>
 #include<iostream>
 #include <algorithm>
+#include <functional>
 #include <iterator>
+#include <vector>
+#include "ParallelChunks.h"
+#include "OutBuffer.h"
 
 /*-- helper function declarations --*/
 void putln(size_t num = 1);
@@ -79,12 +88,56 @@ void idiomatic_iterate_byte_array() {
   std::for_each(std::begin(ba), std::end(ba), f);
 }
 
+/*-----------------------------------------------
+  Iterate large arrays in chunks, in parallel
+
+  par::chunks cuts a contiguous range into spans,
+  and par::parallel runs the views of a pipeline
+  over each span on a pool of threads, merging
+  span results in order.
+*/
+void parallel_iterate_byte_array() {
+  putln();
+  puttxt("-- using par::chunks --");
+  byte ba[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+  for(auto chunk : par::chunks(ba, 4)) {
+    put_coll(chunk, "\n  ");
+  }
+  putln();
+
+  puttxt("-- using par::parallel pipeline --");
+  auto is_even = [](byte item) { return item % 2 == 0; };
+  auto square = [](byte item) { return long(item) * item; };
+  par::work_pool pool;
+
+  auto evens = 
+    par::parallel(ba, pool, 4).filter(is_even).collect();
+  put_coll(evens, "\n  even items of ba: ");
+
+  std::vector<byte> big(10'000'000);
+  for(size_t i = 0; i < big.size(); ++i)
+    big[i] = byte(i % 100);
+  long psum = par::parallel(big, pool)
+    .filter(is_even)
+    .transform(square)
+    .reduce(0L, std::plus<>());
+  long sum = 0;
+  for(auto item : big | std::views::filter(is_even) 
+                      | std::views::transform(square))
+    sum += item;
+  std::cout << "\n  sum of even squares of " << big.size()
+            << " items: " << psum << " on " << pool.size()
+            << " thread(s), " << sum << " with serial views";
+  putln();
+}
+
 int main() {
     std::cout 
         << "\n  -- C++ iter'n over byte arrays --\n";
 
     iterate_byte_array();
     idiomatic_iterate_byte_array();
+    parallel_iterate_byte_array();
 
     std::cout << "\n\n  That's all Folks!\n\n";
 }
@@ -94,19 +147,21 @@ int main() {
   for console output
 */
 void putln(size_t num) {
-  for(size_t i=0; i<num; ++i)
-    std::cout << "\n";
+  std::cout << std::string(num, '\n');
 }
 void puttxt(const std::string& txt) {
   std::cout << "\n  " << txt;
 }
+/*-----------------------------------------------
+  collection helpers format all items into an
+  OutBuffer, which writes them in one call when
+  it goes out of scope
+*/
 /*-- helper function displays collection items --*/
 template<typename C>
 void put_coll(
   C& coll, const std::string& prefix
 ) {
-  std::cout << prefix;
-  for(auto item : coll) {
-    std::cout << item << " ";
-  }
+  Utilities::OutBuffer out;
+  out.putColl(coll, " ", prefix);
 }
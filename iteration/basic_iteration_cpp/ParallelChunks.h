@@ -0,0 +1,315 @@
+#pragma once
+/////////////////////////////////////////////////
+// idioms::basic_iteration_cpp::ParallelChunks.h
+// - iterate large contiguous ranges in        //
+//   cache-sized chunks on a pool of threads   //
+// Jim Fawcett, 17 Oct 2026                    //
+/////////////////////////////////////////////////
+/*
+  Chunked parallel views
+  ----------------------
+  The views in BasicIter.cpp run on one thread.
+  For very large arrays, par::parallel cuts the
+  array into chunks of about 64 KB, runs a view
+  pipeline over each chunk on a work_pool, and
+  merges the chunk results in chunk order:
+
+    par::work_pool pool;
+    long sum = par::parallel(data, pool)
+      .filter([](auto i) { return i % 2 == 0; })
+      .transform([](auto i) { return long(i) * i; })
+      .reduce(0L, std::plus<>());
+
+  - filter and transform stack up, in order, the
+    std::views of the same names applied to each
+    chunk, so a pipeline reads like the serial
+    views and makes no temporaries.
+  - reduce folds each chunk starting from identity,
+    then folds the chunk results in chunk order,
+    so identity must leave values unchanged, like
+    0 for plus.  Chunks don't depend on the number
+    of threads, so results don't either, even for
+    floating point sums.
+  - collect returns the pipeline's values in
+    source order, in a std::vector, so they work
+    with put_coll and other generic code.
+  - par::chunks(r, n) is a view of n element
+    spans of r, like C++23 views::chunk, with
+    n = 0 meaning about 64 KB, as for parallel.
+  - work_pool threads each start with an equal
+    share of chunks, and a thread that runs out
+    steals half of another's remaining share, so
+    uneven chunks don't leave threads idle.  The
+    calling thread works too.
+*/
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace par {
+
+  /*-----------------------------------------------
+    work_pool - runs task(i) for i in [0, count),
+    spread over its threads and the caller's
+  */
+  class work_pool {
+  public:
+    /* threads = 0 uses one thread per core */
+    explicit work_pool(size_t threads = 0) {
+      if(threads == 0)
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+      shares_ = std::make_unique<share[]>(threads);
+      size_ = threads;
+      for(size_t w = 1; w < threads; ++w)
+        workers_.emplace_back([this, w] { work(w); });
+    }
+    ~work_pool() {
+      {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stopping_ = true;
+      }
+      wake_.notify_all();
+      for(auto& t : workers_)
+        t.join();
+    }
+    work_pool(const work_pool&) = delete;
+    work_pool& operator=(const work_pool&) = delete;
+
+    /* threads running tasks, including the caller */
+    size_t size() const { return size_; }
+
+    /*-- run task(i) for each i in [0, count), return when all are done --*/
+    template<typename Task>
+    void run(size_t count, Task&& task) {
+      std::lock_guard<std::mutex> one_batch(run_mtx_);
+      {
+        std::unique_lock<std::mutex> lock(mtx_);
+        done_.wait(lock, [this] { return busy_ == 0; });
+        for(size_t w = 0; w < size_; ++w) {
+          std::lock_guard<std::mutex> share_lock(shares_[w].mtx);
+          shares_[w].next = count * w / size_;
+          shares_[w].end = count * (w + 1) / size_;
+        }
+        context_ = &task;
+        call_ = [](void* context, size_t i) { (*static_cast<Task*>(context))(i); };
+        error_ = nullptr;
+        ++generation_;
+        ++busy_;  // the caller
+      }
+      wake_.notify_all();
+      drain(0, &task, call_);
+      std::exception_ptr error;
+      {
+        std::unique_lock<std::mutex> lock(mtx_);
+        --busy_;
+        done_.wait(lock, [this] { return busy_ == 0; });
+        error = error_;
+      }
+      done_.notify_all();
+      if(error)
+        std::rethrow_exception(error);
+    }
+
+  private:
+    /* a thread's remaining tasks, [next, end) */
+    struct alignas(64) share {
+      std::mutex mtx;
+      size_t next = 0;
+      size_t end = 0;
+    };
+
+    void work(size_t w) {
+      size_t seen = 0;
+      for(;;) {
+        void* context;
+        void (*call)(void*, size_t);
+        {
+          std::unique_lock<std::mutex> lock(mtx_);
+          wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+          if(stopping_)
+            return;
+          seen = generation_;
+          context = context_;
+          call = call_;
+          ++busy_;
+        }
+        drain(w, context, call);
+        {
+          std::lock_guard<std::mutex> lock(mtx_);
+          --busy_;
+        }
+        done_.notify_all();
+      }
+    }
+
+    /*-- run own tasks, then stolen ones, until none are left --*/
+    void drain(size_t w, void* context, void (*call)(void*, size_t)) {
+      size_t i;
+      while(take(w, i) || steal(w, i)) {
+        try {
+          call(context, i);
+        }
+        catch(...) {
+          std::lock_guard<std::mutex> lock(mtx_);
+          if(!error_)
+            error_ = std::current_exception();
+        }
+      }
+    }
+
+    bool take(size_t w, size_t& i) {
+      std::lock_guard<std::mutex> lock(shares_[w].mtx);
+      if(shares_[w].next == shares_[w].end)
+        return false;
+      i = shares_[w].next++;
+      return true;
+    }
+
+    /*-- move upper half of another thread's share to w, and take its first --*/
+    bool steal(size_t w, size_t& i) {
+      for(size_t k = 1; k < size_; ++k) {
+        share& victim = shares_[(w + k) % size_];
+        size_t begin, end;
+        {
+          std::lock_guard<std::mutex> lock(victim.mtx);
+          size_t left = victim.end - victim.next;
+          if(left == 0)
+            continue;
+          begin = victim.end - (left + 1) / 2;
+          end = victim.end;
+          victim.end = begin;
+        }
+        std::lock_guard<std::mutex> lock(shares_[w].mtx);
+        shares_[w].next = begin + 1;
+        shares_[w].end = end;
+        i = begin;
+        return true;
+      }
+      return false;
+    }
+
+    size_t size_ = 0;
+    std::unique_ptr<share[]> shares_;
+    std::vector<std::thread> workers_;
+    std::mutex run_mtx_;
+    std::mutex mtx_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    size_t generation_ = 0;
+    size_t busy_ = 0;
+    bool stopping_ = false;
+    void* context_ = nullptr;
+    void (*call_)(void*, size_t) = nullptr;
+    std::exception_ptr error_;
+  };
+
+  /* elements in a chunk of about 64 KB, the size of a typical L2 share */
+  template<typename T>
+  constexpr size_t default_chunk = std::max<size_t>(1, 64 * 1024 / sizeof(T));
+
+  /*-- view of successive n element spans of contiguous range r, n = 0 for about 64 KB --*/
+  template<std::ranges::contiguous_range R>
+  auto chunks(R& r, size_t n) {
+    std::span data(std::ranges::data(r), std::ranges::size(r));
+    if(n == 0)
+      n = default_chunk<typename decltype(data)::element_type>;
+    size_t count = (data.size() + n - 1) / n;
+    return std::views::iota(size_t(0), count)
+      | std::views::transform([data, n](size_t i) {
+          return data.subspan(i * n, std::min(n, data.size() - i * n));
+        });
+  }
+
+  /*-----------------------------------------------
+    pipeline - views applied to each chunk of data,
+    run on a pool by reduce and collect
+  */
+  template<typename T, typename Stage>
+  class pipeline {
+  public:
+    pipeline(std::span<T> data, work_pool& pool, size_t chunk, Stage stage)
+      : data_(data), pool_(&pool), chunk_(chunk), stage_(stage) {}
+
+    /*-- keep values for which pred is true --*/
+    template<typename Pred>
+    auto filter(Pred pred) const {
+      auto stage = [s = stage_, pred](std::span<T> c) {
+        return s(c) | std::views::filter(pred);
+      };
+      return pipeline<T, decltype(stage)>(data_, *pool_, chunk_, stage);
+    }
+    /*-- replace each value v with fn(v) --*/
+    template<typename Fn>
+    auto transform(Fn fn) const {
+      auto stage = [s = stage_, fn](std::span<T> c) {
+        return s(c) | std::views::transform(fn);
+      };
+      return pipeline<T, decltype(stage)>(data_, *pool_, chunk_, stage);
+    }
+
+    size_t chunk_count() const {
+      return (data_.size() + chunk_ - 1) / chunk_;
+    }
+
+    /*-- fold values with op, chunk results merged in chunk order --*/
+    template<typename V, typename Op>
+    V reduce(V identity, Op op) const {
+      std::vector<V> partials(chunk_count(), identity);
+      pool_->run(partials.size(), [&](size_t i) {
+        V acc = identity;
+        for(auto&& value : stage_(chunk(i)))
+          acc = op(std::move(acc), value);
+        partials[i] = std::move(acc);
+      });
+      V result = identity;
+      for(auto& partial : partials)
+        result = op(std::move(result), std::move(partial));
+      return result;
+    }
+
+    /*-- values in source order --*/
+    auto collect() const {
+      using value = std::ranges::range_value_t<decltype(stage_(std::span<T>()))>;
+      std::vector<std::vector<value>> parts(chunk_count());
+      pool_->run(parts.size(), [&](size_t i) {
+        for(auto&& v : stage_(chunk(i)))
+          parts[i].push_back(v);
+      });
+      size_t total = 0;
+      for(auto& part : parts)
+        total += part.size();
+      std::vector<value> values;
+      values.reserve(total);
+      for(auto& part : parts)
+        values.insert(values.end(), part.begin(), part.end());
+      return values;
+    }
+
+  private:
+    std::span<T> chunk(size_t i) const {
+      return data_.subspan(i * chunk_, std::min(chunk_, data_.size() - i * chunk_));
+    }
+    std::span<T> data_;
+    work_pool* pool_;
+    size_t chunk_;
+    Stage stage_;
+  };
+
+  /*-- start a pipeline over contiguous range r, chunk = 0 for about 64 KB --*/
+  template<std::ranges::contiguous_range R>
+  auto parallel(R& r, work_pool& pool, size_t chunk = 0) {
+    using T = std::remove_reference_t<std::ranges::range_reference_t<R&>>;
+    std::span<T> data(std::ranges::data(r), std::ranges::size(r));
+    if(chunk == 0)
+      chunk = default_chunk<T>;
+    auto stage = [](std::span<T> c) { return c; };
+    return pipeline<T, decltype(stage)>(data, pool, chunk, stage);
+  }
+}
@@ -0,0 +1,188 @@
+#pragma once
+/////////////////////////////////////////////////
+// idioms::iteration_cpp::CharClass.h          //
+// - classify every char of a string in one    //
+//   pass, for all classes at once             //
+// Jim Fawcett, 17 Oct 2026                    //
+/////////////////////////////////////////////////
+/*
+  Single-pass character classification
+  ------------------------------------
+  Testing text with one std::all_of per predicate
+  walks it once per predicate.  classify(text)
+  walks it once, looking up each char's class
+  bits in a 256 entry table, and returns the
+  AND and OR of those bits:
+
+    auto s = char_class::classify(text);
+    s.all_of(char_class::alpha)   every char alphabetic
+    s.any_of(char_class::digit)   some char is a digit
+
+  - classes follow the "C" locale, so chars
+    with the high bit set are in no class
+  - on x86/x64, SSE2 classifies 16 chars per
+    step with byte compares equivalent to the
+    table, which handles the tail
+  - count(text, classes) counts chars in any of
+    classes, in one pass, with no filter view
+
+    References:
+    -----------
+    std::isalpha ...
+      https://en.cppreference.com/w/cpp/string/byte/isalpha
+*/
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CHARCLASS_SSE2
+#include <immintrin.h>
+#endif
+
+namespace char_class {
+
+  /*-- class bits, a char may have several --*/
+  enum : uint8_t {
+    alpha = 1 << 0,
+    digit = 1 << 1,
+    alnum = 1 << 2,
+    space = 1 << 3,
+    upper = 1 << 4,
+    lower = 1 << 5,
+    punct = 1 << 6,
+    ascii = 1 << 7,
+  };
+
+  /*-- class bits of one char, as the "C" locale defines them --*/
+  constexpr uint8_t classes_of(unsigned char ch) {
+    uint8_t bits = 0;
+    bool is_upper = 'A' <= ch && ch <= 'Z';
+    bool is_lower = 'a' <= ch && ch <= 'z';
+    bool is_digit = '0' <= ch && ch <= '9';
+    if(is_upper) bits |= upper | alpha | alnum;
+    if(is_lower) bits |= lower | alpha | alnum;
+    if(is_digit) bits |= digit | alnum;
+    if(ch == ' ' || ('\t' <= ch && ch <= '\r')) bits |= space;
+    if('!' <= ch && ch <= '~' && !is_upper && !is_lower && !is_digit)
+      bits |= punct;
+    if(ch < 128) bits |= ascii;
+    return bits;
+  }
+
+  inline constexpr std::array<uint8_t, 256> table = [] {
+    std::array<uint8_t, 256> t{};
+    for(size_t i = 0; i < t.size(); ++i)
+      t[i] = classes_of(static_cast<unsigned char>(i));
+    return t;
+  }();
+
+  /*-- classes held by all, and by any, chars of a text --*/
+  struct Summary {
+    uint8_t all = 0xff;   // empty text is in every class
+    uint8_t any = 0;
+    size_t size = 0;
+
+    /* every char is in each of classes */
+    bool all_of(uint8_t classes) const {
+      return (all & classes) == classes;
+    }
+    /* some char is in one of classes */
+    bool any_of(uint8_t classes) const {
+      return (any & classes) != 0;
+    }
+    bool none_of(uint8_t classes) const {
+      return !any_of(classes);
+    }
+  };
+
+#ifdef CHARCLASS_SSE2
+  namespace detail {
+    /*-- true lanes where lo <= ch <= hi, for ascii lo and hi --*/
+    inline __m128i in_range(__m128i ch, char lo, char hi) {
+      // shift lo to -128, then one signed compare tests the range;
+      // bytes outside it, including those >= 128, land above
+      __m128i shifted = _mm_add_epi8(ch, _mm_set1_epi8(static_cast<char>(-128 - lo)));
+      return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + hi - lo + 1)));
+    }
+    inline __m128i bits_if(__m128i lanes, uint8_t bits) {
+      return _mm_and_si128(lanes, _mm_set1_epi8(static_cast<char>(bits)));
+    }
+    /*-- class bytes of 16 chars, same as table lookups --*/
+    inline __m128i classify16(const char* p) {
+      __m128i ch = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      __m128i up = in_range(ch, 'A', 'Z');
+      __m128i lo = in_range(ch, 'a', 'z');
+      __m128i dg = in_range(ch, '0', '9');
+      __m128i sp = _mm_or_si128(
+        _mm_cmpeq_epi8(ch, _mm_set1_epi8(' ')), in_range(ch, '\t', '\r')
+      );
+      __m128i an = _mm_or_si128(_mm_or_si128(up, lo), dg);
+      __m128i pu = _mm_andnot_si128(an, in_range(ch, '!', '~'));
+      __m128i bits = _mm_or_si128(bits_if(up, upper | alpha | alnum), bits_if(lo, lower | alpha | alnum));
+      bits = _mm_or_si128(bits, bits_if(dg, digit | alnum));
+      bits = _mm_or_si128(bits, bits_if(sp, space));
+      bits = _mm_or_si128(bits, bits_if(pu, punct));
+      // ascii bit is the complement of the sign bit
+      return _mm_or_si128(bits, _mm_andnot_si128(ch, _mm_set1_epi8(static_cast<char>(ascii))));
+    }
+    /*-- fold 16 bytes into one with op --*/
+    template<typename Op>
+    uint8_t fold16(__m128i v, Op op) {
+      v = op(v, _mm_srli_si128(v, 8));
+      v = op(v, _mm_srli_si128(v, 4));
+      v = op(v, _mm_srli_si128(v, 2));
+      v = op(v, _mm_srli_si128(v, 1));
+      return static_cast<uint8_t>(_mm_cvtsi128_si32(v));
+    }
+  }
+#endif
+
+  /*-- one pass over text, for all classes --*/
+  inline Summary classify(std::string_view text) {
+    Summary s;
+    s.size = text.size();
+    const char* p = text.data();
+    size_t i = 0;
+#ifdef CHARCLASS_SSE2
+    if(text.size() >= 16) {
+      __m128i all = _mm_set1_epi8(-1);
+      __m128i any = _mm_setzero_si128();
+      for(; i + 16 <= text.size(); i += 16) {
+        __m128i bits = detail::classify16(p + i);
+        all = _mm_and_si128(all, bits);
+        any = _mm_or_si128(any, bits);
+      }
+      s.all = detail::fold16(all, [](__m128i a, __m128i b) { return _mm_and_si128(a, b); });
+      s.any = detail::fold16(any, [](__m128i a, __m128i b) { return _mm_or_si128(a, b); });
+    }
+#endif
+    for(; i < text.size(); ++i) {
+      uint8_t bits = table[static_cast<unsigned char>(p[i])];
+      s.all &= bits;
+      s.any |= bits;
+    }
+    return s;
+  }
+
+  /*-- number of chars of text in any of classes --*/
+  inline size_t count(std::string_view text, uint8_t classes) {
+    size_t n = 0;
+    const char* p = text.data();
+    size_t i = 0;
+#ifdef CHARCLASS_SSE2
+    const __m128i wanted = _mm_set1_epi8(static_cast<char>(classes));
+    const __m128i zero = _mm_setzero_si128();
+    for(; i + 16 <= text.size(); i += 16) {
+      __m128i hit = _mm_and_si128(detail::classify16(p + i), wanted);
+      unsigned misses = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(hit, zero)));
+      n += 16 - std::popcount(misses);
+    }
+#endif
+    for(; i < text.size(); ++i)
+      n += (table[static_cast<unsigned char>(p[i])] & classes) != 0;
+    return n;
+  }
+}
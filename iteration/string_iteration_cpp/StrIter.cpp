@@ -13,6 +13,10 @@
   characters with null terminator.
   - ascii characters are all 1 byte, so String 
     instances can be indexed.
+  - a String may also hold UTF-8, where a
+    character takes 1 to 4 bytes, so indexing
+    finds bytes.  Utf8.h validates that text
+    and iterates over its code points.
 
     References:
     -----------
@@ -30,6 +34,11 @@
       https://jimfawcett.github.io/CppStory_LibrarySTL.html#algor
     std::all_of ...
       https://en.cppreference.com/w/cpp/algorithm/all_any_none_of
+
+    Files Required:
+    ---------------
+    StrIter.cpp, CharClass.h, Utf8.h
+    OutBuffer.h (timers/Cpp/src)
 */
 #include<string>
 #include<ranges>
@@ -40,6 +49,9 @@
 #include <typeinfo>
 #include <iterator>
 #include <vector>
+#include "CharClass.h"
+#include "Utf8.h"
+#include "OutBuffer.h"
 
 /*-- helper function declarations --*/
 void putln(size_t num = 1);
@@ -148,6 +160,23 @@ void string_adapters() {
   );
   putln();
 
+  /*---------------------------------------------
+    Each all_of above, and the distance over the
+    filter view, walks ls again.  classify walks
+    it once, collecting every class at once, and
+    count replaces the filter and distance.
+  */
+  puttxt("-- classifying in one pass --");
+  char_class::Summary summary = char_class::classify(ls);
+  test(summary.all_of(char_class::alpha), ls, "alphabetic");
+  test(summary.all_of(char_class::alnum), ls, "alphanumeric");
+  test(summary.all_of(char_class::ascii), ls, "ascii");
+  test(summary.all_of(char_class::digit), ls, "numeric");
+  std::cout << "\n  ls has " 
+            << char_class::count(ls, char_class::digit)
+            << " numeric chars";
+  putln();
+
   puttxt("-- iterating over string slice --");
   ls = "abc123";
   std::string_view slice{ ls };  // non-owning view
@@ -186,12 +215,50 @@ void string_adapters() {
   putln();
 }
 
+/*-----------------------------------------------
+  demonstrate UTF-8 validation and iteration
+  -----------------------------------------------
+  is_ascii replaces all_of with the is_ascii
+  lambda, and code_points steps over each
+  multi-byte sequence, decoding it in place.
+*/
+void utf8_iteration() {
+  puttxt("-- UTF-8 code points --");
+
+  std::string ls = "abc123";
+  test(utf8::is_ascii(ls), ls, "ascii");
+
+  /* a, n with tilde, euro sign, grinning face */
+  std::string text = "a\xC3\xB1\xE2\x82\xAC\xF0\x9F\x98\x80";
+  std::cout << "\n  text has " << text.size() << " bytes";
+  std::cout << (utf8::is_ascii(text) ? ", all" : ", not all")
+            << " ascii";
+  std::cout << (utf8::is_valid(text) ? ", valid" : ", not valid")
+            << " UTF-8";
+  std::cout << "\n  code points:";
+  for(char32_t cp : utf8::code_points(text)) {
+    std::cout << " U+" << std::hex << std::uppercase 
+              << static_cast<uint32_t>(cp) << std::dec;
+  }
+  auto points = utf8::code_points(text);
+  std::cout << "\n  " << std::ranges::distance(points) 
+            << " code points";
+
+  /* 0xC0 0xAF is an overlong encoding of '/' */
+  std::string overlong = "a\xC0\xAF";
+  std::cout << "\n  \"a\\xC0\\xAF\" is "
+            << (utf8::is_valid(overlong) ? "" : "not ")
+            << "valid UTF-8";
+  putln();
+}
+
 int main() {
     puttxt("-- demonstrate string iteration --\n");
 
     string_iteration();
     idomatic_string_iteration();
     string_adapters();
+    utf8_iteration();
 
     std::cout << "\n\n  That's all Folks!\n\n";
 }
@@ -200,30 +267,30 @@ int main() {
   for console output
 */
 void putln(size_t num) {
-  for(size_t i=0; i<num; ++i)
-    std::cout << "\n";
+  std::cout << std::string(num, '\n');
 }
 void puttxt(const std::string& txt) {
   std::cout << "\n  " << txt;
 }
+/*-----------------------------------------------
+  collection helpers format all items into an
+  OutBuffer, which writes them in one call when
+  it goes out of scope
+*/
 /*-- helper func displays collection items --*/
 template<typename C>
 void put_coll(
   C& coll, const std::string& prefix
 ) {
-  std::cout << prefix;
-  for(auto item : coll) {
-    std::cout << item << " ";
-  }
+  Utilities::OutBuffer out;
+  out.putColl(coll, " ", prefix);
 }
 template<typename C>
 void put_coll_tight(
   C& coll, const std::string& prefix
 ) {
-  std::cout << prefix;
-  for(auto item : coll) {
-    std::cout << item;
-  }
+  Utilities::OutBuffer out;
+  out.putColl(coll, "", prefix);
 }
 /*-- helper function, displays test results --*/
 void test(
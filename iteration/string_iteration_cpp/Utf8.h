@@ -0,0 +1,358 @@
+#pragma once
+/////////////////////////////////////////////////
+// idioms::iteration_cpp::Utf8.h               //
+// - validate ascii and UTF-8 text, and        //
+//   iterate over its code points              //
+// Jim Fawcett, 17 Oct 2026                    //
+/////////////////////////////////////////////////
+/*
+  UTF-8 validation and code point iteration
+  -----------------------------------------
+  A std::string holds bytes.  Ascii text uses one
+  byte per char, but UTF-8 text encodes each code
+  point in one to four bytes, so indexing a string
+  finds bytes, not chars.
+
+    utf8::is_ascii(text)      every byte < 128
+    utf8::is_valid(text)      well formed UTF-8
+    for(char32_t cp : utf8::code_points(text))
+      ...                     each code point
+
+  - is_ascii tests 64 bytes per step with SSE2.
+  - is_valid follows simdjson's validator: each
+    16 byte block is checked with three nibble
+    table lookups (SSSE3) that flag every
+    malformed pair of bytes at once, and blocks
+    of ascii are skipped 64 bytes at a time.
+    CPUs without SSSE3, and other targets, use
+    is_valid_scalar, which checks the byte ranges
+    of the Unicode standard's Table 3-7.
+  - code_points iterators decode each code point
+    in place from its bytes.  Text should be
+    valid; a byte that can't start a sequence
+    yields U+FFFD and a step of one byte.
+
+    References:
+    -----------
+    Validating UTF-8 In Less Than One Instruction Per Byte
+      https://arxiv.org/abs/2010.03090
+    Unicode Standard, Table 3-7
+      https://www.unicode.org/versions/latest/ch03.pdf
+*/
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define UTF8_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define UTF8_TARGET(isa)
+#else
+#define UTF8_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace utf8 {
+
+  /*-- are all bytes of text ascii? --*/
+  inline bool is_ascii(std::string_view text) {
+    const char* p = text.data();
+    size_t i = 0;
+#ifdef UTF8_X86
+    for(; i + 64 <= text.size(); i += 64) {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+      __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 16));
+      __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 32));
+      __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 48));
+      if(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0)
+        return false;
+    }
+#endif
+    uint64_t high = 0;
+    for(; i + 8 <= text.size(); i += 8) {
+      uint64_t word;
+      std::memcpy(&word, p + i, 8);
+      high |= word;
+    }
+    for(; i < text.size(); ++i)
+      high |= static_cast<unsigned char>(p[i]);
+    return (high & 0x8080808080808080ull) == 0;
+  }
+
+  /*-- well formed UTF-8, one sequence at a time --*/
+  inline bool is_valid_scalar(std::string_view text) {
+    auto p = reinterpret_cast<const unsigned char*>(text.data());
+    auto end = p + text.size();
+    while(p < end) {
+      if(end - p >= 8) {  // skip ascii a word at a time
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        if((word & 0x8080808080808080ull) == 0) {
+          p += 8;
+          continue;
+        }
+      }
+      unsigned char lead = *p;
+      if(lead < 0x80) {
+        ++p;
+        continue;
+      }
+      /* continuation count and range of first continuation byte */
+      ptrdiff_t conts;
+      unsigned char lo = 0x80, hi = 0xBF;
+      if(0xC2 <= lead && lead <= 0xDF)
+        conts = 1;
+      else if(0xE0 <= lead && lead <= 0xEF) {
+        conts = 2;
+        if(lead == 0xE0) lo = 0xA0;        // overlong
+        else if(lead == 0xED) hi = 0x9F;   // surrogates
+      }
+      else if(0xF0 <= lead && lead <= 0xF4) {
+        conts = 3;
+        if(lead == 0xF0) lo = 0x90;        // overlong
+        else if(lead == 0xF4) hi = 0x8F;   // above U+10FFFF
+      }
+      else
+        return false;
+      if(end - p <= conts || p[1] < lo || p[1] > hi)
+        return false;
+      for(ptrdiff_t i = 2; i <= conts; ++i) {
+        if((p[i] & 0xC0) != 0x80)
+          return false;
+      }
+      p += conts + 1;
+    }
+    return true;
+  }
+
+#ifdef UTF8_X86
+  namespace detail {
+
+    /*-- does this CPU support SSSE3? --*/
+    inline bool has_ssse3() {
+#if defined(_MSC_VER) && !defined(__clang__)
+      int info[4];
+      __cpuid(info, 1);
+      return (info[2] & (1 << 9)) != 0;
+#else
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("ssse3");
+#endif
+    }
+
+    /*-- errors a pair of bytes can show, from simdjson --*/
+    enum : uint8_t {
+      too_short = 1 << 0,       // lead not followed by continuation
+      too_long = 1 << 1,        // ascii followed by continuation
+      overlong_3 = 1 << 2,
+      too_large = 1 << 3,
+      surrogate = 1 << 4,
+      overlong_2 = 1 << 5,
+      too_large_1000 = 1 << 6,
+      overlong_4 = 1 << 6,
+      two_conts = 1 << 7,       // may be fine, checked against leads
+      carry = too_short | too_long | two_conts,
+    };
+
+    struct Ssse3State {
+      __m128i error = _mm_setzero_si128();
+      __m128i prev_input = _mm_setzero_si128();
+      __m128i prev_incomplete = _mm_setzero_si128();
+    };
+
+    UTF8_TARGET("ssse3") inline __m128i lookup(const uint8_t* table, __m128i nibbles) {
+      return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table)), nibbles);
+    }
+    UTF8_TARGET("ssse3") inline __m128i high_nibbles(__m128i v) {
+      return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F));
+    }
+
+    /*-- nonzero lanes where a byte pair, or a 3 or 4 byte sequence, is malformed --*/
+    UTF8_TARGET("ssse3") inline __m128i block_errors(__m128i input, __m128i prev_input) {
+      static constexpr uint8_t byte_1_high[16] = {
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+        two_conts, two_conts, two_conts, two_conts,
+        too_short | overlong_2,
+        too_short,
+        too_short | overlong_3 | surrogate,
+        too_short | too_large | too_large_1000 | overlong_4
+      };
+      static constexpr uint8_t byte_1_low[16] = {
+        carry | overlong_3 | overlong_2 | overlong_4,
+        carry | overlong_2,
+        carry, carry,
+        carry | too_large,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000 | surrogate,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000
+      };
+      static constexpr uint8_t byte_2_high[16] = {
+        too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_short, too_short, too_short, too_short
+      };
+      __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+      __m128i special = _mm_and_si128(
+        _mm_and_si128(
+          lookup(byte_1_high, high_nibbles(prev1)),
+          lookup(byte_1_low, _mm_and_si128(prev1, _mm_set1_epi8(0x0F)))
+        ),
+        lookup(byte_2_high, high_nibbles(input))
+      );
+      /* third and fourth bytes of 3 and 4 byte sequences must be continuations */
+      __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+      __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+      __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+      __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+      __m128i must_be_cont = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+      return _mm_xor_si128(must_be_cont, special);
+    }
+
+    /*-- nonzero lanes where a sequence starting in the last 3 bytes runs past them --*/
+    UTF8_TARGET("ssse3") inline __m128i incomplete(__m128i input) {
+      const __m128i max = _mm_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1)
+      );
+      return _mm_subs_epu8(input, max);
+    }
+
+    UTF8_TARGET("ssse3") inline void check(__m128i input, Ssse3State& s) {
+      if(_mm_movemask_epi8(input) == 0) {
+        s.error = _mm_or_si128(s.error, s.prev_incomplete);
+        s.prev_incomplete = _mm_setzero_si128();
+      }
+      else {
+        s.error = _mm_or_si128(s.error, block_errors(input, s.prev_input));
+        s.prev_incomplete = incomplete(input);
+      }
+      s.prev_input = input;
+    }
+
+    UTF8_TARGET("ssse3") inline bool is_valid_ssse3(const char* p, size_t size) {
+      Ssse3State s;
+      size_t i = 0;
+      for(; i + 64 <= size; i += 64) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 16));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 32));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 48));
+        if(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) == 0) {
+          s.error = _mm_or_si128(s.error, s.prev_incomplete);
+          s.prev_incomplete = _mm_setzero_si128();
+          s.prev_input = d;
+          continue;
+        }
+        check(a, s);
+        check(b, s);
+        check(c, s);
+        check(d, s);
+      }
+      for(; i + 16 <= size; i += 16)
+        check(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), s);
+      /* pad the tail with zeros, which end any incomplete sequence with an error */
+      alignas(16) char tail[16] = {};
+      if(size > i)  // p may be null for empty text, which memcpy forbids
+        std::memcpy(tail, p + i, size - i);
+      __m128i last = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+      s.error = _mm_or_si128(s.error, block_errors(last, s.prev_input));
+      return _mm_movemask_epi8(_mm_cmpeq_epi8(s.error, _mm_setzero_si128())) == 0xFFFF;
+    }
+  }
+#endif
+
+  /*-- is text well formed UTF-8? --*/
+  inline bool is_valid(std::string_view text) {
+#ifdef UTF8_X86
+    static const bool ssse3 = detail::has_ssse3();
+    if(ssse3)
+      return detail::is_valid_ssse3(text.data(), text.size());
+#endif
+    return is_valid_scalar(text);
+  }
+
+  /*-----------------------------------------------
+    code_points - view of the code points of UTF-8
+    text, decoded in place as iteration reaches them
+  */
+  class code_points : public std::ranges::view_interface<code_points> {
+  public:
+    class iterator {
+    public:
+      using value_type = char32_t;
+      using difference_type = std::ptrdiff_t;
+      using iterator_concept = std::forward_iterator_tag;
+
+      iterator() = default;
+      iterator(const char* pos, const char* end) : pos_(pos), end_(end), length_(length()) {}
+
+      /* code point starting at this position */
+      char32_t operator*() const {
+        auto p = reinterpret_cast<const unsigned char*>(pos_);
+        switch(length_) {
+        case 1: return p[0] < 0x80 ? p[0] : 0xFFFD;
+        case 2: return (char32_t(p[0] & 0x1F) << 6) | (p[1] & 0x3F);
+        case 3: return (char32_t(p[0] & 0x0F) << 12) | (char32_t(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+        default:
+          return (char32_t(p[0] & 0x07) << 18) | (char32_t(p[1] & 0x3F) << 12)
+               | (char32_t(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+        }
+      }
+      /* bytes encoding this code point */
+      std::string_view bytes() const {
+        return std::string_view(pos_, length_);
+      }
+      iterator& operator++() {
+        pos_ += length_;
+        length_ = length();
+        return *this;
+      }
+      iterator operator++(int) {
+        iterator old = *this;
+        ++*this;
+        return old;
+      }
+      bool operator==(const iterator& other) const {
+        return pos_ == other.pos_;
+      }
+    private:
+      /* bytes in sequence, from lead byte's leading ones, or 1 if no lead */
+      size_t length() const {
+        if(pos_ == end_)
+          return 0;
+        size_t ones = std::countl_one(static_cast<unsigned char>(*pos_));
+        if(ones < 2 || ones > 4 || ones > static_cast<size_t>(end_ - pos_))
+          return 1;
+        return ones;
+      }
+      const char* pos_ = nullptr;
+      const char* end_ = nullptr;
+      size_t length_ = 0;
+    };
+
+    code_points() = default;
+    explicit code_points(std::string_view text) : text_(text) {}
+
+    iterator begin() const {
+      return iterator(text_.data(), text_.data() + text_.size());
+    }
+    iterator end() const {
+      const char* end = text_.data() + text_.size();
+      return iterator(end, end);
+    }
+  private:
+    std::string_view text_;
+  };
+}
@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////
+// BenchConversions.cpp - DateTime benchmarks              //
+//                                                         //
+// Jim Fawcett, https://JimFawcett.github.io, 17 Oct 2026  //
+/////////////////////////////////////////////////////////////
+/*
+    bench_datetime - BenchHarness suite for DateTime
+    conversions:
+    - construct from a time point and read fields()
+    - time(), ctime text as std::string
+    - formatTo and formatTimePoint, ctime and ISO-8601
+    - parse ctime as local time and as UTC, parse ISO-8601
+    - toCalendarLocal and toCalendarUtc, 1024 value columns
+
+    Files Required:
+    ---------------
+    BenchConversions.cpp
+    BenchHarness.h, BenchHarness.cpp
+    DateTime.h, DateTime.cpp, DateTimeBatch.h, DateTimeBatch.cpp
+    CivilTime.h, Stopwatch.h, Stopwatch.cpp
+*/
+#include <string>
+#include <vector>
+#include "BenchHarness.h"
+#include "DateTime.h"
+#include "DateTimeBatch.h"
+
+using namespace Utilities;
+
+int main(int argc, char* argv[]) {
+  BenchHarness bench("datetime", BenchOptions::fromArgs(argc, argv));
+
+  DateTime::TimePoint tp = DateTime::SysClock::now();
+  char buffer[DateTime::formatSize];
+
+  bench.run("fields", [&] { doNotOptimize(DateTime(tp).fields()); });
+  bench.run("time", [&] { doNotOptimize(DateTime(tp).time()); });
+  bench.run("formatTo ctime", [&] { doNotOptimize(DateTime(tp).formatTo(buffer, sizeof(buffer))); });
+  bench.run("formatTo iso8601", [&] {
+    doNotOptimize(DateTime(tp).formatTo(buffer, sizeof(buffer), DateTime::Format::iso8601));
+  });
+  bench.run("formatTimePoint cached", [&] {
+    doNotOptimize(DateTime::formatTimePoint(tp, buffer, sizeof(buffer)));
+  });
+
+  std::string ctimeText = DateTime(tp).time();
+  std::string isoText(buffer, DateTime(tp).formatTo(buffer, sizeof(buffer), DateTime::Format::iso8601Utc));
+  DateTime::TimePoint parsed;
+  bench.run("parse ctime local", [&] {
+    doNotOptimize(DateTime::parse(ctimeText, parsed, DateTime::Zone::local));
+    doNotOptimize(parsed);
+  });
+  bench.run("parse ctime utc", [&] {
+    doNotOptimize(DateTime::parse(ctimeText, parsed, DateTime::Zone::utc));
+    doNotOptimize(parsed);
+  });
+  bench.run("parse iso8601", [&] {
+    doNotOptimize(DateTime::parse(isoText, parsed, DateTime::Zone::utc));
+    doNotOptimize(parsed);
+  });
+
+  constexpr size_t n = 1024;
+  std::vector<DateTime::TimePoint> column(n);
+  for (size_t i = 0; i < n; ++i)
+    column[i] = tp + std::chrono::seconds(3607 * i);
+  std::vector<int32_t> y(n), mo(n), d(n), h(n), mi(n), s(n);
+  CalendarColumns columns{ y, mo, d, h, mi, s };
+  UtcOffsetCache offsets;
+  bench.run("toCalendarLocal x1024", [&] {
+    toCalendarLocal(column, columns, offsets);
+    clobberMemory();
+  });
+  bench.run("toCalendarUtc x1024", [&] {
+    toCalendarUtc(column, columns);
+    clobberMemory();
+  });
+  return bench.finish();
+}
@@ -0,0 +1,259 @@
+/////////////////////////////////////////////////////////////
+// BenchDateTime.cpp - cost of DateTime conversions        //
+//                                                         //
+// Jim Fawcett, https://JimFawcett.github.io, 17 Oct 2026  //
+/////////////////////////////////////////////////////////////
+/*
+    Measures the cost, per timestamp, of building a full
+    timestamp: the formatted time plus year, month, day,
+    hour, minute, and second.
+    - uncached: one local time conversion per field, as
+      DateTime ver 1.1 did
+    - cached: DateTime ver 1.2, one conversion reused by
+      time() and fields()
+
+    Then measures timestamps parsed per second:
+    - istringstream parser of ver 1.1, with mktime
+    - DateTime::parse of ctime strings as local time, with mktime
+    - DateTime::parse of ctime strings as UTC
+    - DateTime::parse of ISO-8601 strings with a Z suffix
+
+    Then measures the cost of formatting a logger's stream
+    of timestamps, many per second:
+    - time(), ctime into a new std::string
+    - formatTo, into a caller buffer
+    - formatTimePoint, reusing this thread's last second
+
+    Then measures converting a column of a million points,
+    about a year apart from first to last, to calendar fields:
+    - DateTime::fields, one localtime call per value
+    - toCalendarLocal, offsets cached per daylight saving window
+    - toCalendarUtc, no offsets
+
+    Files Required:
+    ---------------
+    BenchDateTime.cpp
+    DateTime.h, DateTime.cpp
+    DateTimeBatch.h, DateTimeBatch.cpp, CivilTime.h
+    Stopwatch.h, Stopwatch.cpp
+*/
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <unordered_map>
+#include <functional>
+#include "DateTime.h"
+#include "DateTimeBatch.h"
+#include "Stopwatch.h"
+
+using namespace Utilities;
+
+/*-- one field, converted from scratch, as in ver 1.1 --*/
+size_t uncachedField(const DateTime::TimePoint& tp, int std::tm::* field)
+{
+  std::time_t t = DateTime::SysClock::to_time_t(tp);
+  std::tm tm;
+  DateTime::localtime(&t, &tm);
+  return static_cast<size_t>(tm.*field);
+}
+/*-- full timestamp with a conversion per field --*/
+size_t uncached(const DateTime::TimePoint& tp)
+{
+  std::time_t t = DateTime::SysClock::to_time_t(tp);
+  char buffer[DateTime::ctimeSize];
+  DateTime::ctime(&t, buffer, DateTime::ctimeSize);
+  std::string ts = buffer;
+  return ts.size()
+    + uncachedField(tp, &std::tm::tm_year) + uncachedField(tp, &std::tm::tm_mon)
+    + uncachedField(tp, &std::tm::tm_mday) + uncachedField(tp, &std::tm::tm_hour)
+    + uncachedField(tp, &std::tm::tm_min) + uncachedField(tp, &std::tm::tm_sec);
+}
+/*-- full timestamp with one cached conversion --*/
+size_t cached(const DateTime::TimePoint& tp)
+{
+  DateTime dt(tp);
+  std::string ts = dt.time();
+  DateTime::Fields f = dt.fields();
+  return ts.size() + f.year + f.month + f.day + f.hour + f.minute + f.second;
+}
+/*-- best of 5 runs over all points, nanosecs per timestamp --*/
+double nanosPerStamp(const std::vector<DateTime::TimePoint>& points, size_t (*stamp)(const DateTime::TimePoint&))
+{
+  double best = 1e300;
+  volatile size_t sink = 0;
+  for (size_t run = 0; run < 5; ++run)
+  {
+    Stopwatch sw;
+    sw.start();
+    size_t sum = 0;
+    for (auto& tp : points)
+      sum += stamp(tp);
+    sw.stop();
+    sink = sink + sum;
+    best = std::min(best, static_cast<double>(sw.elapsedNanoseconds()) / points.size());
+  }
+  return best;
+}
+
+/*-- ver 1.1 string parser, kept as the baseline --*/
+int readDateTimePart(int& part, std::istringstream& in)
+{
+  if (in.peek() == ':')
+    in.get();
+  in >> part;
+  if (in.good())
+    return part;
+  return -1;
+}
+DateTime::TimePoint parseBaseline(const std::string& dtStr)
+{
+  static const std::unordered_map<std::string, size_t> months = {
+    { "Jan", 1 }, { "Feb", 2 }, { "Mar", 3 }, { "Apr", 4 },
+    { "May", 5 }, { "Jun", 6 }, { "Jul", 7 }, { "Aug", 8 },
+    { "Sep", 9 }, { "Oct", 10 }, { "Nov", 11 }, { "Dec", 12 }
+  };
+  std::istringstream in(dtStr);
+  std::string day, month;
+  in >> day;
+  in >> month;
+  std::tm date{};
+  date.tm_mon = static_cast<int>(months.find(month)->second) - 1;
+  readDateTimePart(date.tm_mday, in);
+  readDateTimePart(date.tm_hour, in);
+  readDateTimePart(date.tm_min, in);
+  readDateTimePart(date.tm_sec, in);
+  readDateTimePart(date.tm_year, in);
+  date.tm_year -= 1900;
+  date.tm_isdst = -1;
+  return DateTime::SysClock::from_time_t(std::mktime(&date));
+}
+/*-- best of 5 runs over all strings, millions parsed per sec --*/
+double millionsPerSec(
+  const std::vector<std::string>& strs, const std::function<DateTime::TimePoint(const std::string&)>& parse
+)
+{
+  double best = 1e300;
+  volatile int64_t sink = 0;
+  for (size_t run = 0; run < 5; ++run)
+  {
+    Stopwatch sw;
+    sw.start();
+    int64_t sum = 0;
+    for (auto& str : strs)
+      sum += parse(str).time_since_epoch().count();
+    sw.stop();
+    sink = sink + sum;
+    best = std::min(best, static_cast<double>(sw.elapsedNanoseconds()));
+  }
+  return static_cast<double>(strs.size()) / best * 1000.0;
+}
+/*-- best of 5 conversions of a column, nanosecs per value --*/
+double nanosPerValue(const std::function<void()>& convert, size_t count)
+{
+  double best = 1e300;
+  for (size_t run = 0; run < 5; ++run)
+  {
+    Stopwatch sw;
+    sw.start();
+    convert();
+    sw.stop();
+    best = std::min(best, static_cast<double>(sw.elapsedNanoseconds()) / count);
+  }
+  return best;
+}
+
+int main() {
+  std::cout << "\n  -- DateTime per-timestamp cost --\n";
+
+  std::vector<DateTime::TimePoint> points;
+  DateTime::TimePoint base = DateTime::SysClock::now();
+  for (size_t i = 0; i < 200000; ++i)
+    points.push_back(base + std::chrono::milliseconds(1237 * i));
+
+  double before = nanosPerStamp(points, uncached);
+  double after = nanosPerStamp(points, cached);
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "\n  uncached, conversion per field: " << std::setw(8) << before << " nanosecs";
+  std::cout << "\n  cached, one conversion:         " << std::setw(8) << after << " nanosecs";
+  std::cout << "\n  speedup:                        " << std::setw(8) << before / after;
+
+  std::cout << "\n\n  -- DateTime string parsing, millions per sec --\n";
+
+  std::vector<std::string> ctimes, isos;
+  for (size_t i = 0; i < points.size(); i += 2)
+  {
+    ctimes.push_back(DateTime(points[i]).time());
+    std::time_t t = DateTime::SysClock::to_time_t(points[i]);
+    std::tm tm = *std::gmtime(&t);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &tm);
+    isos.push_back(buffer);
+  }
+  auto fast = [](DateTime::Zone zone) {
+    return [zone](const std::string& str) {
+      DateTime::TimePoint tp;
+      DateTime::parse(str, tp, zone);
+      return tp;
+    };
+  };
+  std::cout << std::setprecision(2);
+  std::cout << "\n  ver 1.1 istringstream, local:   " << std::setw(8) << millionsPerSec(ctimes, parseBaseline);
+  std::cout << "\n  parse ctime, local (mktime):    " << std::setw(8) << millionsPerSec(ctimes, fast(DateTime::Zone::local));
+  std::cout << "\n  parse ctime, UTC:               " << std::setw(8) << millionsPerSec(ctimes, fast(DateTime::Zone::utc));
+  std::cout << "\n  parse ISO-8601, Z:              " << std::setw(8) << millionsPerSec(isos, fast(DateTime::Zone::utc));
+
+  std::cout << "\n\n  -- DateTime formatting, nanosecs per timestamp --\n";
+
+  std::vector<DateTime::TimePoint> stamps;
+  for (size_t i = 0; i < 200000; ++i)
+    stamps.push_back(base + std::chrono::microseconds(50 * i));  // 20000 per second
+  std::cout << std::setprecision(1);
+  std::cout << "\n  time(), ctime std::string:          " << std::setw(8)
+            << nanosPerStamp(stamps, [](const DateTime::TimePoint& tp) { return DateTime(tp).time().size(); });
+  std::cout << "\n  formatTo, ctime:                   " << std::setw(8)
+            << nanosPerStamp(stamps, [](const DateTime::TimePoint& tp) {
+                 char buffer[DateTime::formatSize];
+                 return DateTime(tp).formatTo(buffer, sizeof(buffer));
+               });
+  std::cout << "\n  formatTimePoint, ctime, cached:    " << std::setw(8)
+            << nanosPerStamp(stamps, [](const DateTime::TimePoint& tp) {
+                 char buffer[DateTime::formatSize];
+                 return DateTime::formatTimePoint(tp, buffer, sizeof(buffer));
+               });
+  std::cout << "\n  formatTimePoint, ISO-8601, cached: " << std::setw(8)
+            << nanosPerStamp(stamps, [](const DateTime::TimePoint& tp) {
+                 char buffer[DateTime::formatSize];
+                 return DateTime::formatTimePoint(tp, buffer, sizeof(buffer), DateTime::Format::iso8601);
+               });
+
+  std::cout << "\n\n  -- column conversion, nanosecs per value --\n";
+
+  std::vector<DateTime::TimePoint> column;
+  for (size_t i = 0; i < 1000000; ++i)
+    column.push_back(base + std::chrono::milliseconds(31537 * i));
+  size_t n = column.size();
+  std::vector<int32_t> y(n), mo(n), d(n), h(n), mi(n), sec(n);
+  CalendarColumns columns{ y, mo, d, h, mi, sec };
+
+  double perValue = nanosPerValue([&] {
+    for (size_t i = 0; i < n; ++i)
+    {
+      DateTime::Fields f = DateTime(column[i]).fields();
+      y[i] = static_cast<int32_t>(f.year) + 1900;
+      mo[i] = static_cast<int32_t>(f.month) + 1;
+      d[i] = static_cast<int32_t>(f.day);
+      h[i] = static_cast<int32_t>(f.hour);
+      mi[i] = static_cast<int32_t>(f.minute);
+      sec[i] = static_cast<int32_t>(f.second);
+    }
+  }, n);
+  double local = nanosPerValue([&] { toCalendarLocal(column, columns); }, n);
+  double utc = nanosPerValue([&] { toCalendarUtc(column, columns); }, n);
+  std::cout << "\n  DateTime::fields per value:        " << std::setw(8) << perValue;
+  std::cout << "\n  toCalendarLocal:                   " << std::setw(8) << local;
+  std::cout << "\n  toCalendarUtc:                     " << std::setw(8) << utc;
+  std::cout << "\n  local speedup:                     " << std::setw(8) << perValue / local;
+  std::cout << "\n\n  That's all Folks!\n\n";
+}
@@ -0,0 +1,262 @@
+/////////////////////////////////////////////////////////////////////
+// BenchHarness.cpp - repeatable micro-benchmarks                  //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+
+#include "BenchHarness.h"
+#include "DateTime.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+using namespace Utilities;
+
+//----< options from command line, throws on unknown options >-------
+
+BenchOptions BenchOptions::fromArgs(int argc, char* argv[])
+{
+  BenchOptions options;
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    auto value = [&]() -> std::string {
+      if (i + 1 >= argc)
+        throw std::invalid_argument("BenchOptions: " + arg + " needs a value");
+      return argv[++i];
+    };
+    if (arg == "--json")
+      options.json = value();
+    else if (arg == "--filter")
+      options.filter = value();
+    else if (arg == "--cpu")
+      options.cpu = std::stoi(value());
+    else if (arg == "--samples")
+      options.samples = std::max<size_t>(1, std::stoul(value()));
+    else if (arg == "--sample-ms")
+      options.sampleMs = std::stod(value());
+    else if (arg == "--warmup-ms")
+      options.warmupMs = std::stod(value());
+    else if (arg == "--quick")
+    {
+      options.samples = 5;
+      options.sampleMs = 2.0;
+      options.warmupMs = 10.0;
+    }
+    else
+      throw std::invalid_argument("BenchOptions: unknown option " + arg);
+  }
+  return options;
+}
+//----< pin this thread, reporting the CPU pinned to >---------------
+
+BenchHarness::BenchHarness(std::string suite, BenchOptions options)
+  : suite_(std::move(suite)), options_(std::move(options))
+{
+  int cpu = options_.cpu == -2 ? currentCpu() : options_.cpu;
+  if (cpu >= 0 && pinToCpu(cpu))
+    cpu_ = cpu;
+}
+//----< run this thread only on cpu >--------------------------------
+
+bool BenchHarness::pinToCpu(int cpu)
+{
+#if defined(_WIN32)
+  if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+    return false;
+  return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+  if (cpu >= CPU_SETSIZE)
+    return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+//----< CPU this thread is running on, or -1 if unknown >------------
+
+int BenchHarness::currentCpu()
+{
+#if defined(_WIN32)
+  return static_cast<int>(GetCurrentProcessorNumber());
+#elif defined(__linux__)
+  return sched_getcpu();
+#else
+  return -1;
+#endif
+}
+
+bool BenchHarness::selected(const std::string& name) const
+{
+  return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+}
+//----< calibrate, warm up, and time samples of one benchmark >------
+/*
+ * Grows the batch tenfold until it takes a tenth of the target, then
+ * scales it to the target, so calibration costs about two batches.
+ * Batches are capped at 2^32 calls, reached only by bodies the
+ * compiler has removed, which report about zero.
+ */
+void BenchHarness::measure(const std::string& name, const Batch& batch)
+{
+  constexpr double maxIterations = 4294967296.0;
+  const double target = options_.sampleMs * 1.0e6;
+  uint64_t iterations = 1;
+  double elapsed = static_cast<double>(batch(iterations));
+  while (elapsed < target / 10 && iterations < maxIterations / 10)
+  {
+    iterations *= 10;
+    elapsed = static_cast<double>(batch(iterations));
+  }
+  double scaled = static_cast<double>(iterations) * target / std::max(elapsed, 1.0);
+  iterations = static_cast<uint64_t>(std::clamp(scaled, 1.0, maxIterations));
+
+  Stopwatch warm;
+  warm.start();
+  do
+    batch(iterations);
+  while (warm.elapsedMilliseconds() < options_.warmupMs);
+
+  std::vector<double> perCall(options_.samples);
+  for (double& sample : perCall)
+    sample = static_cast<double>(batch(iterations)) / static_cast<double>(iterations);
+
+  double mean = 0.0;
+  for (double sample : perCall)
+    mean += sample;
+  mean /= static_cast<double>(perCall.size());
+  double squares = 0.0;
+  for (double sample : perCall)
+    squares += (sample - mean) * (sample - mean);
+  double stddev = perCall.size() > 1 ? std::sqrt(squares / static_cast<double>(perCall.size() - 1)) : 0.0;
+
+  std::sort(perCall.begin(), perCall.end());
+  size_t mid = perCall.size() / 2;
+  double median = perCall.size() % 2 ? perCall[mid] : (perCall[mid - 1] + perCall[mid]) / 2;
+  results_.push_back(BenchResult{ name, iterations, perCall.size(), perCall.front(), median, mean, stddev });
+}
+//----< results table, nanoseconds per call >------------------------
+
+void BenchHarness::print(std::ostream& out) const
+{
+  size_t width = 12;
+  for (auto& result : results_)
+    width = std::max(width, result.name.size() + 2);
+
+  out << "\n  -- " << suite_ << " benchmarks, nanosecs per call";
+  if (cpu_ >= 0)
+    out << ", pinned to CPU " << cpu_;
+  out << " --\n";
+  out << "\n  " << std::left << std::setw(static_cast<int>(width)) << "benchmark" << std::right
+      << std::setw(12) << "min" << std::setw(12) << "median" << std::setw(12) << "mean"
+      << std::setw(12) << "stddev" << std::setw(14) << "calls/sample";
+  out << std::fixed << std::setprecision(2);
+  for (auto& result : results_)
+  {
+    out << "\n  " << std::left << std::setw(static_cast<int>(width)) << result.name << std::right
+        << std::setw(12) << result.minNs << std::setw(12) << result.medianNs
+        << std::setw(12) << result.meanNs << std::setw(12) << result.stddevNs
+        << std::setw(14) << result.iterations;
+  }
+  out << "\n";
+}
+//----< results as JSON, one object per benchmark >------------------
+
+namespace
+{
+  std::string quoted(const std::string& text)
+  {
+    std::string out = "\"";
+    for (char ch : text)
+    {
+      if (ch == '"' || ch == '\\')
+        out += '\\';
+      if (static_cast<unsigned char>(ch) < 0x20)
+        continue;
+      out += ch;
+    }
+    return out + "\"";
+  }
+}
+
+void BenchHarness::writeJson(std::ostream& out) const
+{
+  char stamp[DateTime::formatSize];
+  size_t length = DateTime::formatNow(stamp, sizeof(stamp), DateTime::Format::iso8601Utc);
+
+  out << "{\n  \"suite\": " << quoted(suite_)
+      << ",\n  \"date\": " << quoted(std::string(stamp, length))
+      << ",\n  \"cpu\": " << cpu_
+      << ",\n  \"results\": [";
+  out << std::setprecision(6) << std::defaultfloat;
+  for (size_t i = 0; i < results_.size(); ++i)
+  {
+    const BenchResult& r = results_[i];
+    out << (i == 0 ? "\n" : ",\n")
+        << "    { \"name\": " << quoted(r.name)
+        << ", \"iterations\": " << r.iterations
+        << ", \"samples\": " << r.samples
+        << ", \"min_ns\": " << r.minNs
+        << ", \"median_ns\": " << r.medianNs
+        << ", \"mean_ns\": " << r.meanNs
+        << ", \"stddev_ns\": " << r.stddevNs << " }";
+  }
+  out << "\n  ]\n}\n";
+}
+//----< print results, write JSON if asked, returns exit code >------
+
+int BenchHarness::finish()
+{
+  print();
+  if (options_.json.empty())
+    return 0;
+  std::ofstream out(options_.json);
+  if (!out)
+  {
+    std::cerr << "\n  can't open " << options_.json << "\n";
+    return 1;
+  }
+  writeJson(out);
+  std::cout << "\n  wrote " << options_.json << "\n";
+  return 0;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_BENCHHARNESS
+
+#include <thread>
+#include "StringUtilities.h"
+
+int main(int argc, char* argv[])
+{
+  Utilities::Title("Testing BenchHarness");
+
+  BenchHarness bench("harness", BenchOptions::fromArgs(argc, argv));
+  bench.run("empty", [] {});
+  uint64_t value = 1;
+  bench.run("multiply", [&] {
+    value = value * 6364136223846793005ull + 1;
+    doNotOptimize(value);
+  });
+  bench.run("sleep 1 ms", [] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+  bench.finish();
+  bench.writeJson(std::cout);
+  std::cout << "\n";
+}
+#endif
@@ -0,0 +1,150 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// BenchHarness.h - repeatable micro-benchmarks                    //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+/*
+ * Package Operations:
+ * -------------------
+ * BenchHarness runs a benchmark body many times and reports the time
+ * per call, so changes in speed show up as numbers.
+ *
+ *   int main(int argc, char* argv[]) {
+ *     BenchHarness bench("strings", BenchOptions::fromArgs(argc, argv));
+ *     bench.run("trim", [&] { doNotOptimize(trim(text)); });
+ *     return bench.finish();   // table on stdout, JSON if --json given
+ *   }
+ *
+ * For each benchmark run():
+ * - pins the thread to one CPU, by default the one it started on
+ * - finds an iteration count whose batch takes sampleMs
+ * - runs batches for warmupMs to settle caches, branch predictors,
+ *   and clock frequency
+ * - times samples batches with Stopwatch, reporting min, median,
+ *   mean, and standard deviation of nanoseconds per call
+ * finish() prints the results and writes them as JSON, stamped with
+ * the DateTime of the run, for comparing builds.
+ *
+ * Command line options, read by BenchOptions::fromArgs:
+ *   --json path      write results as JSON to path
+ *   --filter text    run only benchmarks whose names contain text
+ *   --cpu n          pin to CPU n, -1 to not pin
+ *   --samples n      batches timed per benchmark, default 21
+ *   --sample-ms x    target milliseconds per batch, default 10
+ *   --warmup-ms x    milliseconds of warm-up, default 100
+ *   --quick          5 samples of 2 ms, 10 ms warm-up
+ *
+ * Required Files:
+ * ---------------
+ *   BenchHarness.h, BenchHarness.cpp, Stopwatch.h, Stopwatch.cpp,
+ *   DateTime.h, DateTime.cpp
+ *
+ * Maintenance History:
+ * --------------------
+ * ver 1.0 : 17 Oct 2026
+ * - first release
+*/
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Stopwatch.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace Utilities
+{
+  //----< keep the compiler from discarding value's computation >------
+
+  template <typename T>
+  inline void doNotOptimize(const T& value)
+  {
+#if defined(_MSC_VER) && !defined(__clang__)
+    const volatile char* sink = &reinterpret_cast<const volatile char&>(value);
+    (void)*sink;
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+  }
+  //----< make the compiler assume memory was read and written >-------
+
+  inline void clobberMemory()
+  {
+#if defined(_MSC_VER) && !defined(__clang__)
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+  }
+
+  struct BenchOptions
+  {
+    std::string json;
+    std::string filter;
+    int cpu = -2;  // -2 pins to the starting CPU, -1 doesn't pin
+    size_t samples = 21;
+    double sampleMs = 10.0;
+    double warmupMs = 100.0;
+
+    static BenchOptions fromArgs(int argc, char* argv[]);
+  };
+
+  struct BenchResult
+  {
+    std::string name;
+    uint64_t iterations;  // calls per sample
+    size_t samples;
+    double minNs;         // per call
+    double medianNs;
+    double meanNs;
+    double stddevNs;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // BenchHarness - runs, times, and reports a suite of benchmarks
+
+  class BenchHarness
+  {
+  public:
+    explicit BenchHarness(std::string suite, BenchOptions options = BenchOptions());
+
+    template <typename Body>
+    void run(const std::string& name, Body&& body)
+    {
+      if (!selected(name))
+        return;
+      measure(name, [&body](uint64_t iterations) {
+        Stopwatch sw;
+        sw.start();
+        for (uint64_t i = 0; i < iterations; ++i)
+          body();
+        sw.stop();
+        return sw.elapsedNanoseconds();
+      });
+    }
+    const std::vector<BenchResult>& results() const { return results_; }
+    int pinnedCpu() const { return cpu_; }
+
+    void print(std::ostream& out = std::cout) const;
+    void writeJson(std::ostream& out) const;
+    int finish();
+
+    static bool pinToCpu(int cpu);
+    static int currentCpu();
+  private:
+    using Batch = std::function<uint64_t(uint64_t)>;
+    bool selected(const std::string& name) const;
+    void measure(const std::string& name, const Batch& batch);
+
+    std::string suite_;
+    BenchOptions options_;
+    int cpu_ = -1;
+    std::vector<BenchResult> results_;
+  };
+}
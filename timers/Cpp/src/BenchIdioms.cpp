@@ -0,0 +1,306 @@
+/////////////////////////////////////////////////////////////
+// BenchIdioms.cpp - iteration and DIP idiom benchmarks    //
+//                                                         //
+// Jim Fawcett, https://JimFawcett.github.io, 17 Oct 2026  //
+/////////////////////////////////////////////////////////////
+/*
+    bench_idioms - BenchHarness suite for the idioms shown in
+    iteration/basic_iteration_cpp, iteration/string_iteration_cpp,
+    and DepInvPrinciple/CalcDemo-Cpp.  Those are demo programs,
+    each with its own main, so their idioms are restated here,
+    summing or counting where the demos print.
+    - byte array: iterator loop, range-based for, views::take,
+      std::for_each, and 64 MB filter | transform | reduce with
+      serial views and with par::parallel on all cores
+    - string: classify with four std::all_of passes, count
+      digits with views::filter, and both in one pass each
+      with CharClass.h, on 4 KB and 1 MB of text
+    - UTF-8: 1 MB of ascii tested with the is_ascii lambda and
+      with Utf8.h, 1 MB of mixed UTF-8 validated by the scalar
+      and SSSE3 validators, and iterated by code point
+    - calc: Plus and Times called through a virtual interface
+      held by unique_ptr, and called directly as template
+      parameters, over 1024 argument pairs, and batches of
+      1024 with virtual calls, with Calc::calc_batch, and
+      with the operation looked up by name in CalcDispatch.h
+    - say: 4096 Say components, alternating two kinds, called
+      through unique_ptrs to a virtual interface in shuffled
+      order, and by for_each over a SayStore of SayRegistry.h
+    - calc 10M: (a + b) * c over 10 million doubles, step by
+      step with calc_batch through a temporary, and fused into
+      one loop with CalcExpr.h
+
+    Files Required:
+    ---------------
+    BenchIdioms.cpp, CharClass.h, Utf8.h (iteration/string_iteration_cpp)
+    ParallelChunks.h (iteration/basic_iteration_cpp)
+    GenericCalc.h, CalcExpr.h, CalcDispatch.h (DepInvPrinciple/CalcDemo-Cpp)
+    SayRegistry.h (DepInvPrinciple/BasicDip-Cpp)
+    BenchHarness.h, BenchHarness.cpp
+    Stopwatch.h, Stopwatch.cpp, DateTime.h, DateTime.cpp
+*/
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+#include "BenchHarness.h"
+#include "CharClass.h"
+#include "Utf8.h"
+#include "ParallelChunks.h"
+#include "GenericCalc.h"
+#include "CalcExpr.h"
+#include "CalcDispatch.h"
+#include "SayRegistry.h"
+
+using namespace Utilities;
+
+/*-- Calc abstraction, dispatched at run time, the baseline for GenericCalc.h --*/
+template <typename T>
+struct VirtualCalc
+{
+  virtual ~VirtualCalc() = default;
+  virtual T calc(T arg1, T arg2) = 0;
+};
+template <typename T>
+struct VirtualPlus : VirtualCalc<T>
+{
+  T calc(T arg1, T arg2) override { return arg1 + arg2; }
+};
+template <typename T>
+struct VirtualTimes : VirtualCalc<T>
+{
+  T calc(T arg1, T arg2) override { return arg1 * arg2; }
+};
+
+template <typename Op, typename T>
+T calcAll(Op& op, const std::vector<T>& a, const std::vector<T>& b)
+{
+  T sum = 0;
+  for (size_t i = 0; i < a.size(); ++i)
+    sum += op.calc(a[i], b[i]);
+  return sum;
+}
+
+/*-- Say components, summing ids where BasicDIP's print --*/
+size_t saidSum = 0;
+struct VirtualSay
+{
+  virtual ~VirtualSay() = default;
+  virtual void say() = 0;
+};
+struct VirtualFirst : VirtualSay
+{
+  explicit VirtualFirst(Byte id) : id(id) {}
+  void say() override { saidSum += id; }
+  Byte id;
+};
+struct VirtualSecond : VirtualSay
+{
+  explicit VirtualSecond(Byte id) : id(id) {}
+  void say() override { saidSum += 2 * id; }
+  Byte id;
+};
+struct QuietFirst : Say<QuietFirst>
+{
+  static constexpr std::string_view name = "First";
+  void say() { saidSum += id_; }
+};
+struct QuietSecond : Say<QuietSecond>
+{
+  static constexpr std::string_view name = "Second";
+  void say() { saidSum += 2 * id_; }
+};
+
+int main(int argc, char* argv[]) {
+  par::work_pool pool;  // before the harness pins this thread, so workers aren't pinned
+  BenchHarness bench("idioms", BenchOptions::fromArgs(argc, argv));
+
+  using byte = short int;
+  std::vector<byte> bytes(4096);
+  std::iota(bytes.begin(), bytes.end(), byte(0));
+  byte* ba = bytes.data();
+  byte* baEnd = ba + bytes.size();
+
+  bench.run("array iterator loop", [&] {
+    long sum = 0;
+    for (byte* it = ba; it != baEnd; ++it)
+      sum += *it;
+    doNotOptimize(sum);
+  });
+  bench.run("array range for", [&] {
+    long sum = 0;
+    for (auto i : bytes)
+      sum += i;
+    doNotOptimize(sum);
+  });
+  bench.run("array views::take", [&] {
+    long sum = 0;
+    for (auto i : bytes | std::views::take(bytes.size() - 1))
+      sum += i;
+    doNotOptimize(sum);
+  });
+  bench.run("array for_each", [&] {
+    long sum = 0;
+    std::for_each(ba, baEnd, [&sum](auto item) { sum += item; });
+    doNotOptimize(sum);
+  });
+
+  std::vector<byte> big(32 * 1024 * 1024);
+  for (size_t i = 0; i < big.size(); ++i)
+    big[i] = byte(i % 100);
+  auto is_even = [](byte item) { return item % 2 == 0; };
+  auto square = [](byte item) { return long(item) * item; };
+  bench.run("array 64MB serial views", [&] {
+    long sum = 0;
+    for (auto item : big | std::views::filter(is_even) | std::views::transform(square))
+      sum += item;
+    doNotOptimize(sum);
+  });
+  bench.run("array 64MB par::parallel", [&] {
+    doNotOptimize(par::parallel(big, pool).filter(is_even).transform(square).reduce(0L, std::plus<>()));
+  });
+
+  std::string ls;
+  while (ls.size() < 4096)
+    ls += "abc123";
+  /* <cctype> is undefined for negative chars, so pass them unsigned */
+  auto is_alpha = [](char ch) -> bool { return std::isalpha(static_cast<unsigned char>(ch)); };
+  auto is_alnum = [](char ch) -> bool { return std::isalnum(static_cast<unsigned char>(ch)); };
+  auto is_ascii = [](char ch) -> bool { return static_cast<unsigned char>(ch) < 128; };
+  auto is_num = [](char ch) -> bool { return std::isdigit(static_cast<unsigned char>(ch)); };
+
+  bench.run("string all_of x4", [&] {
+    int classes = std::all_of(ls.begin(), ls.end(), is_alpha)
+                + std::all_of(ls.begin(), ls.end(), is_alnum) * 2
+                + std::all_of(ls.begin(), ls.end(), is_ascii) * 4
+                + std::all_of(ls.begin(), ls.end(), is_num) * 8;
+    doNotOptimize(classes);
+  });
+  bench.run("string views::filter", [&] {
+    auto digits = ls | std::views::filter(is_num);
+    doNotOptimize(std::ranges::distance(digits.begin(), digits.end()));
+  });
+  bench.run("string classify 1 pass", [&] {
+    char_class::Summary s = char_class::classify(ls);
+    int classes = s.all_of(char_class::alpha)
+                + s.all_of(char_class::alnum) * 2
+                + s.all_of(char_class::ascii) * 4
+                + s.all_of(char_class::digit) * 8;
+    doNotOptimize(classes);
+  });
+  bench.run("string count digits", [&] {
+    doNotOptimize(char_class::count(ls, char_class::digit));
+  });
+
+  std::string text;  // alnum and ascii passes run to the end, as for ls
+  while (text.size() < (1 << 20))
+    text += "Quick7Brown5Fox3Jumps";
+  bench.run("text 1MB all_of x4", [&] {
+    int classes = std::all_of(text.begin(), text.end(), is_alpha)
+                + std::all_of(text.begin(), text.end(), is_alnum) * 2
+                + std::all_of(text.begin(), text.end(), is_ascii) * 4
+                + std::all_of(text.begin(), text.end(), is_num) * 8;
+    doNotOptimize(classes);
+  });
+  bench.run("text 1MB classify 1 pass", [&] {
+    doNotOptimize(char_class::classify(text));
+  });
+
+  bench.run("ascii 1MB is_ascii lambda", [&] {
+    doNotOptimize(std::all_of(text.begin(), text.end(), is_ascii));
+  });
+  bench.run("ascii 1MB utf8::is_ascii", [&] { doNotOptimize(utf8::is_ascii(text)); });
+  bench.run("ascii 1MB utf8::is_valid", [&] { doNotOptimize(utf8::is_valid(text)); });
+
+  std::string mixed;  // 1, 2, 3, and 4 byte sequences
+  while (mixed.size() < (1 << 20))
+    mixed += "Se\xC3\xB1or costs 5\xE2\x82\xAC \xF0\x9F\x98\x80 ";
+  bench.run("utf8 1MB is_valid_scalar", [&] { doNotOptimize(utf8::is_valid_scalar(mixed)); });
+  bench.run("utf8 1MB is_valid", [&] { doNotOptimize(utf8::is_valid(mixed)); });
+  bench.run("utf8 1MB code_points", [&] {
+    char32_t sum = 0;
+    for (char32_t cp : utf8::code_points(mixed))
+      sum += cp;
+    doNotOptimize(sum);
+  });
+
+  std::vector<int> a(1024), b(1024);
+  std::iota(a.begin(), a.end(), 1);
+  std::iota(b.begin(), b.end(), 7);
+  std::vector<std::unique_ptr<VirtualCalc<int>>> opers;
+  opers.push_back(std::make_unique<VirtualPlus<int>>());
+  opers.push_back(std::make_unique<VirtualTimes<int>>());
+  size_t which = 0;
+  doNotOptimize(which);
+
+  bench.run("calc virtual x1024", [&] {
+    doNotOptimize(calcAll(*opers[which], a, b));
+  });
+  bench.run("calc template x1024", [&] {
+    Plus<int> plus;
+    doNotOptimize(calcAll(plus, a, b));
+  });
+  std::vector<int> out(a.size());
+  bench.run("calc_batch virtual x1024", [&] {
+    VirtualCalc<int>& oper = *opers[which];
+    for (size_t i = 0; i < out.size(); ++i)
+      out[i] = oper.calc(a[i], b[i]);
+    clobberMemory();
+  });
+  bench.run("calc_batch static x1024", [&] {
+    Plus<int>::create().calc_batch(a, b, out);
+    clobberMemory();
+  });
+  const std::string names[] = { "plus", "times" };
+  bench.run("calc_batch by name x1024", [&] {
+    calc_table<int>().find(names[which]).calc_batch(a, b, out);
+    clobberMemory();
+  });
+
+  std::vector<std::unique_ptr<VirtualSay>> scattered;
+  SayStore<SayRegistry<QuietFirst, QuietSecond>> store;
+  for (Byte id = 0; id < 4096; ++id)
+  {
+    if (id % 2 == 0)
+      scattered.push_back(std::make_unique<VirtualFirst>(id));
+    else
+      scattered.push_back(std::make_unique<VirtualSecond>(id));
+    store.add(id % 2, id);
+  }
+  std::shuffle(scattered.begin(), scattered.end(), std::mt19937(42));
+  bench.run("say virtual x4096", [&] {
+    for (auto& component : scattered)
+      component->say();
+    doNotOptimize(saidSum);
+  });
+  bench.run("say SayStore x4096", [&] {
+    store.for_each([](auto& component) { component.say(); });
+    doNotOptimize(saidSum);
+  });
+
+  const size_t tenMillion = 10'000'000;
+  std::vector<double> da(tenMillion), db(tenMillion), dc(tenMillion);
+  std::vector<double> dtemp(tenMillion), dout(tenMillion);
+  for (size_t i = 0; i < tenMillion; ++i)
+  {
+    da[i] = i * 0.5;
+    db[i] = 1.0 + i % 7;
+    dc[i] = 0.25 * (i % 5);
+  }
+  bench.run("calc 10M step by step", [&] {
+    Plus<double>::create().calc_batch(da, db, dtemp);
+    Times<double>::create().calc_batch(dtemp, dc, dout);
+    clobberMemory();
+  });
+  bench.run("calc 10M fused", [&] {
+    evaluate((calc_arg(da) + calc_arg(db)) * calc_arg(dc), std::span<double>(dout));
+    clobberMemory();
+  });
+  return bench.finish();
+}
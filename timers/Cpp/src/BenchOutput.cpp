@@ -0,0 +1,140 @@
+/////////////////////////////////////////////////////////////
+// BenchOutput.cpp - throughput of collection output       //
+//                                                         //
+// Jim Fawcett, https://JimFawcett.github.io, 17 Oct 2026  //
+/////////////////////////////////////////////////////////////
+/*
+    Measures items/second and MB/s for writing a collection
+    of ints, then of doubles, to the null device:
+    - std::cout << per item, synchronized with stdio, as
+      put_coll did, with stdout redirected for the run
+    - std::ofstream << per item
+    - OutBuffer writing to a file descriptor
+    - OutBuffer writing through a std::ofstream
+
+    Usage: BenchOutput [millionItems]
+      default 10 million items
+
+    Files Required:
+    ---------------
+    BenchOutput.cpp
+    OutBuffer.h, Stopwatch.h, Stopwatch.cpp
+*/
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fcntl.h>
+#include "OutBuffer.h"
+#include "Stopwatch.h"
+
+#ifdef _WIN32
+#include <io.h>
+const char* nullDevice = "NUL";
+int openNull() { return _open(nullDevice, _O_WRONLY); }
+#define dup _dup
+#define dup2 _dup2
+#define close _close
+#else
+#include <unistd.h>
+const char* nullDevice = "/dev/null";
+int openNull() { return open(nullDevice, O_WRONLY); }
+#endif
+
+using namespace Utilities;
+
+/*-- seconds to run write once --*/
+template <typename F>
+double seconds(F write)
+{
+  Stopwatch sw;
+  sw.start();
+  write();
+  sw.stop();
+  return sw.elapsedNanoseconds() / 1e9;
+}
+
+/*-- time each method writing items, separated by spaces --*/
+template <typename T>
+void benchItems(const std::string& label, const std::vector<T>& items)
+{
+  /* streams print doubles with six digits, OutBuffer with all it needs */
+  std::ostringstream streamSizer, bufferSizer;
+  for (auto item : items)
+    streamSizer << item << " ";
+  {
+    OutBuffer out(bufferSizer);
+    out.putColl(items);
+  }
+  double streamMegaBytes = streamSizer.str().size() / 1e6;
+  double bufferMegaBytes = bufferSizer.str().size() / 1e6;
+  double million = items.size() / 1e6;
+
+  auto show = [&](const std::string& method, double secs) {
+    double megaBytes = method.starts_with("OutBuffer") ? bufferMegaBytes : streamMegaBytes;
+    std::cout << "\n  " << std::left << std::setw(10) << label << std::setw(26) << method << std::right
+              << std::setw(12) << million / secs << std::setw(12) << megaBytes / secs;
+    std::cout.flush();
+  };
+
+  int nullFd = openNull();
+  int savedStdout = dup(1);
+  std::cout.flush();
+  dup2(nullFd, 1);
+  double coutSecs = seconds([&] {
+    for (auto item : items)
+      std::cout << item << " ";
+    std::cout.flush();
+  });
+  dup2(savedStdout, 1);
+  close(savedStdout);
+  show("cout << per item", coutSecs);
+
+  {
+    std::ofstream file(nullDevice);
+    show("ofstream << per item", seconds([&] {
+      for (auto item : items)
+        file << item << " ";
+      file.flush();
+    }));
+  }
+  show("OutBuffer to fd", seconds([&] {
+    OutBuffer out(nullFd);
+    out.putColl(items);
+  }));
+  {
+    std::ofstream file(nullDevice);
+    show("OutBuffer to ofstream", seconds([&] {
+      OutBuffer out(file);
+      out.putColl(items);
+    }));
+  }
+  close(nullFd);
+}
+
+int main(int argc, char* argv[])
+{
+  size_t count = 10'000'000;
+  if (argc > 1)
+    count = static_cast<size_t>(std::atof(argv[1]) * 1e6);
+
+  std::vector<int> ints(count);
+  std::vector<double> doubles(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    ints[i] = static_cast<int>(i * 2654435761u % 2000000) - 1000000;
+    doubles[i] = ints[i] / 64.0;
+  }
+
+  std::cout << "\n  -- writing " << count << " items to " << nullDevice << " --\n";
+  std::cout << "\n  " << std::left << std::setw(10) << "items" << std::setw(26) << "method" << std::right
+            << std::setw(12) << "M items/s" << std::setw(12) << "MB/s";
+  std::cout << std::fixed << std::setprecision(1);
+  benchItems("int", ints);
+  benchItems("double", doubles);
+
+  std::cout << "\n\n  That's all Folks!\n\n";
+}
@@ -0,0 +1,82 @@
+/////////////////////////////////////////////////////////////
+// BenchParallelSplit.cpp - scaling of parallel split      //
+//                                                         //
+// Jim Fawcett, https://JimFawcett.github.io, 17 Oct 2026  //
+/////////////////////////////////////////////////////////////
+/*
+    Splits CSV-like text, default 128 MB, with split_view,
+    then with split_view_parallel on 1 to N threads, where
+    N is the number of cores.  Reports MB/s and speedup over
+    the sequential split_view, and checks that every run
+    produces the same tokens.
+
+    Usage: BenchParallelSplit [megaBytes]
+
+    Files Required:
+    ---------------
+    BenchParallelSplit.cpp, BenchText.h
+    ParallelSplit.h, StringUtilities.h, StringScan.h
+*/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include "ParallelSplit.h"
+#include "BenchText.h"
+
+using namespace Utilities;
+
+/*-- best of 3 runs, in seconds --*/
+double bestSeconds(const std::function<void()>& run)
+{
+  using Clock = std::chrono::steady_clock;
+  double best = 1e300;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    auto start = Clock::now();
+    run();
+    std::chrono::duration<double> secs = Clock::now() - start;
+    best = std::min(best, secs.count());
+  }
+  return best;
+}
+
+int main(int argc, char* argv[]) {
+  size_t megaBytes = 128;
+  if (argc > 1)
+    megaBytes = std::strtoul(argv[1], nullptr, 10);
+  size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+  std::cout << "\n  -- parallel split scaling, " << megaBytes << " MB, "
+            << cores << " cores --\n";
+  std::string text = makeText(megaBytes << 20);
+  double mb = static_cast<double>(text.size()) / 1.0e6;
+
+  std::vector<std::string_view> expected;
+  double seqSecs = bestSeconds([&] {
+    std::vector<std::string_view> tokens;
+    for (std::string_view token : split_view(text))
+      tokens.push_back(token);
+    expected = std::move(tokens);
+  });
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "\n  " << std::setw(10) << "threads" << std::setw(12) << "MB/s"
+            << std::setw(12) << "speedup" << std::setw(12) << "same";
+  std::cout << "\n  " << std::setw(10) << "seq" << std::setw(12) << mb / seqSecs
+            << std::setw(12) << 1.0 << std::setw(12) << "yes";
+
+  for (size_t n = 1; n <= cores; n = (n < cores && 2 * n > cores) ? cores : 2 * n)
+  {
+    std::vector<std::string_view> tokens;
+    double secs = bestSeconds([&] { tokens = split_view_parallel(text, ',', n); });
+    std::cout << "\n  " << std::setw(10) << n << std::setw(12) << mb / secs
+              << std::setw(12) << seqSecs / secs
+              << std::setw(12) << (tokens == expected ? "yes" : "NO");
+    std::cout.flush();
+  }
+  std::cout << "\n\n  That's all Folks!\n\n";
+}
@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////
+// BenchReduce.cpp - scaling of calc_reduce with threads   //
+//                                                         //
+// Jim Fawcett, https://JimFawcett.github.io, 17 Oct 2026  //
+/////////////////////////////////////////////////////////////
+/*
+    bench_reduce - BenchHarness suite for CalcReduce.h, in
+    DepInvPrinciple/CalcDemo-Cpp, summing 10 million doubles
+    with Plus:
+    - std::accumulate on one thread, the baseline
+    - calc_reduce fast and deterministic, with 1, 2, 4, ...
+      threads, up to one per core
+
+    Spawned threads inherit the affinity of the thread that
+    starts them, so this suite doesn't pin unless given --cpu.
+
+    Files Required:
+    ---------------
+    BenchReduce.cpp
+    GenericCalc.h, CalcReduce.h (DepInvPrinciple/CalcDemo-Cpp)
+    BenchHarness.h, BenchHarness.cpp
+    Stopwatch.h, Stopwatch.cpp, DateTime.h, DateTime.cpp
+*/
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchHarness.h"
+#include "CalcReduce.h"
+
+using namespace Utilities;
+
+int main(int argc, char* argv[]) {
+  BenchOptions options = BenchOptions::fromArgs(argc, argv);
+  if (options.cpu == -2)
+    options.cpu = -1;
+  BenchHarness bench("reduce", options);
+
+  std::vector<double> values(10'000'000);
+  for (size_t i = 0; i < values.size(); ++i)
+    values[i] = 1.0 / (i + 1);
+  auto plus = Plus<double>::create();
+
+  bench.run("accumulate 10M", [&] {
+    doNotOptimize(std::accumulate(values.begin(), values.end(), 0.0));
+  });
+
+  size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+  std::vector<size_t> threadCounts;
+  for (size_t threads = 1; threads < cores; threads *= 2)
+    threadCounts.push_back(threads);
+  threadCounts.push_back(cores);
+
+  for (size_t threads : threadCounts)
+  {
+    std::string count = std::to_string(threads);
+    bench.run("fast 10M " + count + " threads", [&] {
+      doNotOptimize(calc_reduce(plus, values, 0.0, calc_order::fast, threads));
+    });
+    bench.run("deterministic 10M " + count + " threads", [&] {
+      doNotOptimize(calc_reduce(plus, values, 0.0, calc_order::deterministic, threads));
+    });
+  }
+  return bench.finish();
+}
@@ -0,0 +1,130 @@
+/////////////////////////////////////////////////////////////
+// BenchSplit.cpp - throughput of split implementations    //
+//                                                         //
+// Jim Fawcett, https://JimFawcett.github.io, 17 Oct 2026  //
+/////////////////////////////////////////////////////////////
+/*
+    Measures bytes/second for splitting CSV-like text of
+    1 KB up to a maximum size, default 64 MB:
+    - ver 1.0 split, building tokens char by char (baseline)
+    - split, the string_view based wrapper
+    - delimiter scanning with each StringScan scanner,
+      trimming every token with trim_view
+
+    Usage: BenchSplit [maxMegaBytes]
+      BenchSplit 1024 runs up to 1 GB.  Methods that build
+      a vector of strings are skipped above 64 MB, where
+      the token vector alone would need several GB.
+
+    Files Required:
+    ---------------
+    BenchSplit.cpp, BenchText.h
+    StringUtilities.h, StringScan.h
+*/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include "StringUtilities.h"
+#include "BenchText.h"
+
+using namespace Utilities;
+
+/*-- ver 1.0 split, kept as the baseline --*/
+std::vector<std::string> splitBaseline(const std::string& toSplit, char splitOn = ',')
+{
+  std::vector<std::string> splits;
+  std::string temp;
+  for (char ch : toSplit)
+  {
+    if (ch != splitOn)
+    {
+      temp += ch;
+    }
+    else
+    {
+      splits.push_back(trim(temp));
+      temp.clear();
+    }
+  }
+  if (temp.length() > 0)
+    splits.push_back(trim(temp));
+  return splits;
+}
+/*-- scan with one scanner, trimming each token --*/
+size_t scanTokens(ScanKind kind, const std::string& src, char delim)
+{
+  size_t count = 0, chars = 0, pos = 0;
+  DelimScanner scanner(src.data(), src.size(), delim, kind);
+  while (pos < src.size())
+  {
+    size_t end = scanner.next(pos);
+    std::string_view token = trim_view(std::string_view(src.data() + pos, end - pos));
+    chars += token.size();
+    ++count;
+    pos = end + 1;
+  }
+  return count + chars;
+}
+/*-- best of reps runs, in MB/s --*/
+double megaBytesPerSec(size_t bytes, const std::function<size_t()>& run)
+{
+  using Clock = std::chrono::steady_clock;
+  size_t reps = bytes < (1 << 20) ? 200 : (bytes < (64 << 20) ? 5 : 1);
+  double best = 1e300;
+  volatile size_t sink = 0;
+  for (size_t i = 0; i < reps; ++i)
+  {
+    auto start = Clock::now();
+    sink = sink + run();
+    std::chrono::duration<double> secs = Clock::now() - start;
+    if (secs.count() < best)
+      best = secs.count();
+  }
+  return static_cast<double>(bytes) / best / 1.0e6;
+}
+
+int main(int argc, char* argv[]) {
+  size_t maxMB = 64;
+  if (argc > 1)
+    maxMB = std::strtoul(argv[1], nullptr, 10);
+  const size_t vectorLimit = size_t(64) << 20;
+
+  std::cout << "\n  -- split throughput, MB/s --";
+  std::cout << "\n  best scanner on this CPU: " << scanKindName(bestScanKind()) << "\n";
+  std::cout << "\n  " << std::setw(10) << "size"
+            << std::setw(12) << "ver 1.0" << std::setw(12) << "split"
+            << std::setw(12) << "scalar" << std::setw(12) << "sse2"
+            << std::setw(12) << "avx2";
+
+  std::cout << std::fixed << std::setprecision(1);
+  for (size_t size = 1024; size <= (maxMB << 20); size *= 4)
+  {
+    std::string text = makeText(size);
+    std::string label = size < (1 << 20)
+      ? std::to_string(size >> 10) + " KB" : std::to_string(size >> 20) + " MB";
+    std::cout << "\n  " << std::setw(10) << label;
+
+    if (size <= vectorLimit)
+    {
+      std::cout << std::setw(12) << megaBytesPerSec(size, [&] { return splitBaseline(text).size(); });
+      std::cout << std::setw(12) << megaBytesPerSec(size, [&] { return split(text).size(); });
+    }
+    else
+    {
+      std::cout << std::setw(12) << "skipped" << std::setw(12) << "skipped";
+    }
+    for (ScanKind kind : { ScanKind::scalar, ScanKind::sse2, ScanKind::avx2 })
+    {
+      if (kind == ScanKind::avx2 && bestScanKind() != ScanKind::avx2)
+        std::cout << std::setw(12) << "n/a";
+      else
+        std::cout << std::setw(12) << megaBytesPerSec(size, [&] { return scanTokens(kind, text, ','); });
+    }
+    std::cout.flush();
+  }
+  std::cout << "\n\n  That's all Folks!\n\n";
+}
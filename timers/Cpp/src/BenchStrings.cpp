@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////
+// BenchStrings.cpp - StringUtilities benchmarks           //
+//                                                         //
+// Jim Fawcett, https://JimFawcett.github.io, 17 Oct 2026  //
+/////////////////////////////////////////////////////////////
+/*
+    bench_strings - BenchHarness suite for StringUtilities.h
+    and SplitStream.h, on a 4 KB comma separated line:
+    - trim and trim_view of a padded word
+    - split and split_view on ','
+    - split on "::" and on DelimiterSet { ",", ";", "::" }
+    - StreamSplitter over an istringstream
+
+    Files Required:
+    ---------------
+    BenchStrings.cpp
+    BenchHarness.h, BenchHarness.cpp
+    StringUtilities.h, StringScan.h, SplitStream.h
+    Stopwatch.h, Stopwatch.cpp, DateTime.h, DateTime.cpp
+*/
+#include <string>
+#include <sstream>
+#include "BenchHarness.h"
+#include "StringUtilities.h"
+#include "SplitStream.h"
+
+using namespace Utilities;
+
+/*-- about size chars of "  word_n , " tokens joined by sep --*/
+std::string makeLine(size_t size, const std::string& sep)
+{
+  std::string line;
+  for (size_t i = 0; line.size() < size; ++i)
+    line += "  word_" + std::to_string(i) + " " + sep;
+  return line;
+}
+
+int main(int argc, char* argv[]) {
+  BenchHarness bench("strings", BenchOptions::fromArgs(argc, argv));
+
+  std::string padded = "   \t a padded word of moderate length \n  ";
+  bench.run("trim", [&] { doNotOptimize(trim(padded)); });
+  bench.run("trim_view", [&] { doNotOptimize(trim_view(std::string_view(padded))); });
+
+  std::string commas = makeLine(4096, ",");
+  std::string colons = makeLine(4096, "::");
+  std::string mixed = makeLine(1365, ",") + makeLine(1365, ";") + makeLine(1365, "::");
+
+  bench.run("split 4KB ','", [&] { doNotOptimize(split(commas, ',')); });
+  bench.run("split_view 4KB ','", [&] {
+    size_t chars = 0;
+    for (std::string_view token : split_view(commas, ','))
+      chars += token.size();
+    doNotOptimize(chars);
+  });
+  bench.run("split 4KB \"::\"", [&] { doNotOptimize(split(colons, std::string("::"))); });
+  bench.run("split_view 4KB \"::\"", [&] {
+    size_t chars = 0;
+    for (std::string_view token : split_view(colons, std::string_view("::")))
+      chars += token.size();
+    doNotOptimize(chars);
+  });
+  DelimiterSet delims{ ",", ";", "::" };
+  bench.run("split_view 4KB DelimiterSet", [&] {
+    size_t chars = 0;
+    for (std::string_view token : split_view(mixed, delims))
+      chars += token.size();
+    doNotOptimize(chars);
+  });
+  bench.run("StreamSplitter 4KB ','", [&] {
+    std::istringstream in(commas);
+    StreamSplitter splitter(in, ',', 1024);
+    std::string_view token;
+    size_t chars = 0;
+    while (splitter.next(token))
+      chars += token.size();
+    doNotOptimize(chars);
+  });
+  return bench.finish();
+}
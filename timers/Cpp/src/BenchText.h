@@ -0,0 +1,36 @@
+#ifndef BENCHTEXT_H
+#define BENCHTEXT_H
+/////////////////////////////////////////////////////////////
+// BenchText.h - sample text shared by split benchmarks    //
+//                                                         //
+// Jim Fawcett, https://JimFawcett.github.io, 17 Oct 2026  //
+/////////////////////////////////////////////////////////////
+/*
+    makeText(size) builds size chars of CSV-like text, the
+    same for BenchSplit and BenchParallelSplit, so their
+    results compare.
+
+    Files Required:
+    ---------------
+    BenchText.h
+*/
+#include <string>
+
+/*-- CSV-like text: short fields, padded, many rows --*/
+inline std::string makeText(size_t size)
+{
+  static const char* fields[] = {
+    "alpha", " 42", "3.14159 ", "  quoted text  ", "x", "2026-10-17", "\t-7", "value"
+  };
+  std::string text;
+  text.reserve(size + 32);
+  size_t i = 0;
+  while (text.size() < size)
+  {
+    text += fields[i % 8];
+    text += (++i % 8 == 0) ? '\n' : ',';
+  }
+  text.resize(size);
+  return text;
+}
+#endif
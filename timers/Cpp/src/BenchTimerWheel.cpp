@@ -0,0 +1,156 @@
+/////////////////////////////////////////////////////////////
+// BenchTimerWheel.cpp - timer scheduling throughput       //
+//                                                         //
+// Jim Fawcett, https://JimFawcett.github.io, 17 Oct 2026  //
+/////////////////////////////////////////////////////////////
+/*
+    Schedules half a million timers at random delays of up to
+    ten minutes, cancels every other one, then moves time
+    forward a millisecond at a time until all have fired.
+    Reports millions of operations per second for:
+    - TimerWheel
+    - std::priority_queue ordered by expiry, the usual
+      hand-rolled scheduler, with cancel marking the timer
+      so it is skipped when it reaches the top
+
+    Pass the timer count on the command line to change it.
+
+    Files Required:
+    ---------------
+    BenchTimerWheel.cpp
+    TimerWheel.h, TimerWheel.cpp
+    Stopwatch.h, Stopwatch.cpp
+*/
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <random>
+#include <string>
+#include "TimerWheel.h"
+#include "Stopwatch.h"
+
+using namespace Utilities;
+
+/////////////////////////////////////////////////////////////
+// HeapTimers - priority queue baseline, lazy cancellation
+
+class HeapTimers
+{
+public:
+  using Callback = std::function<void()>;
+
+  uint32_t schedule(uint64_t delay, Callback callback)
+  {
+    uint32_t id = static_cast<uint32_t>(callbacks_.size());
+    callbacks_.push_back(std::move(callback));
+    heap_.push(Entry{ now_ + delay, id });
+    return id;
+  }
+  bool cancel(uint32_t id)
+  {
+    if (!callbacks_[id])
+      return false;
+    callbacks_[id] = nullptr;
+    return true;
+  }
+  size_t advance(uint64_t tick)
+  {
+    now_ = tick;
+    size_t fired = 0;
+    while (!heap_.empty() && heap_.top().expiry <= tick)
+    {
+      uint32_t id = heap_.top().id;
+      heap_.pop();
+      if (callbacks_[id])
+      {
+        Callback callback = std::move(callbacks_[id]);
+        callbacks_[id] = nullptr;
+        callback();
+        ++fired;
+      }
+    }
+    return fired;
+  }
+  bool empty() const { return heap_.empty(); }
+  void reserve(size_t count) { callbacks_.reserve(count); }
+private:
+  struct Entry
+  {
+    uint64_t expiry;
+    uint32_t id;
+    bool operator>(const Entry& other) const { return expiry > other.expiry; }
+  };
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap_;
+  std::vector<Callback> callbacks_;
+  uint64_t now_ = 0;
+};
+
+struct Rates
+{
+  double insert;
+  double cancel;
+  double fire;
+};
+
+/*-- millions per second of count operations taking nanos --*/
+double mops(size_t count, uint64_t nanos)
+{
+  return static_cast<double>(count) / static_cast<double>(nanos) * 1000.0;
+}
+
+template <typename Timers, typename Id>
+Rates measure(const std::vector<uint64_t>& delays, uint64_t horizon)
+{
+  Timers timers;
+  timers.reserve(delays.size());
+  std::vector<Id> ids(delays.size());
+  size_t hits = 0;
+  Stopwatch sw;
+
+  sw.start();
+  for (size_t i = 0; i < delays.size(); ++i)
+    ids[i] = timers.schedule(delays[i], [&hits] { ++hits; });
+  sw.stop();
+  double insert = mops(delays.size(), sw.elapsedNanoseconds());
+
+  sw.start();
+  size_t cancelled = 0;
+  for (size_t i = 0; i < ids.size(); i += 2)
+    cancelled += timers.cancel(ids[i]);
+  sw.stop();
+  double cancel = mops(cancelled, sw.elapsedNanoseconds());
+
+  sw.start();
+  size_t fired = 0;
+  for (uint64_t tick = 1; tick <= horizon; ++tick)
+    fired += timers.advance(tick);
+  sw.stop();
+  double fire = mops(fired, sw.elapsedNanoseconds());
+
+  if (fired != delays.size() - cancelled || hits != fired)
+    std::cout << "\n  error: fired " << fired << " of " << delays.size() - cancelled;
+  return Rates{ insert, cancel, fire };
+}
+
+int main(int argc, char* argv[]) {
+  size_t count = 500000;
+  if (argc > 1)
+    count = std::stoul(argv[1]);
+  const uint64_t horizon = 600000;  // ten minutes of millisecond ticks
+
+  std::mt19937_64 rng(17);
+  std::vector<uint64_t> delays(count);
+  for (auto& delay : delays)
+    delay = 1 + rng() % horizon;
+
+  std::cout << "\n  -- " << count << " timers, millions of operations per sec --\n";
+  Rates wheel = measure<TimerWheel, TimerId>(delays, horizon);
+  Rates heap = measure<HeapTimers, uint32_t>(delays, horizon);
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "\n               " << std::setw(10) << "insert" << std::setw(10) << "cancel" << std::setw(10) << "fire";
+  std::cout << "\n  TimerWheel   " << std::setw(10) << wheel.insert << std::setw(10) << wheel.cancel << std::setw(10) << wheel.fire;
+  std::cout << "\n  heap         " << std::setw(10) << heap.insert << std::setw(10) << heap.cancel << std::setw(10) << heap.fire;
+  std::cout << "\n\n  That's all Folks!\n\n";
+}
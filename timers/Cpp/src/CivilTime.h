@@ -0,0 +1,115 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// CivilTime.h - calendar arithmetic without the C library         //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+/*
+ * Package Operations:
+ * -------------------
+ * Converts between proleptic Gregorian dates and days since the Unix
+ * epoch, 1 Jan 1970, using Howard Hinnant's days_from_civil and
+ * civil_from_days algorithms.  All functions are constexpr, branch
+ * light, and use no tables, so loops over them vectorize.
+ * - daysFromCivil(y, m, d)   days since epoch, m is 1 - 12
+ * - civilFromDays(days)      { year, month 1 - 12, day 1 - 31 }
+ * - isLeapYear(y), daysInMonth(y, m)
+ * - monthFromName("Jan")     1 - 12, or 0 if not a month abbreviation
+ *
+ * Required Files:
+ * ---------------
+ *   CivilTime.h
+ *
+ * Maintenance History:
+ * --------------------
+ * ver 1.0 : 17 Oct 2026
+ * - first release
+*/
+
+#include <cstdint>
+#include <string_view>
+
+namespace Utilities
+{
+  struct CivilDate
+  {
+    int64_t year;
+    unsigned month;  // 1 - 12
+    unsigned day;    // 1 - 31
+  };
+
+  //----< days since 1 Jan 1970 of a Gregorian date >------------------
+
+  constexpr int64_t daysFromCivil(int64_t y, unsigned m, unsigned d)
+  {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);             // [0, 399]
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;  // [0, 365]
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;            // [0, 146096]
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+  }
+  //----< Gregorian date of days since 1 Jan 1970 >--------------------
+
+  constexpr CivilDate civilFromDays(int64_t z)
+  {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);                // [0, 146096]
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                // [0, 365]
+    const unsigned mp = (5 * doy + 2) / 153;                                     // [0, 11]
+    const unsigned d = doy - (153 * mp + 2) / 5 + 1;                             // [1, 31]
+    const unsigned m = mp < 10 ? mp + 3 : mp - 9;                                // [1, 12]
+    return CivilDate{ static_cast<int64_t>(yoe) + era * 400 + (m <= 2), m, d };
+  }
+  //----< is y a Gregorian leap year? >--------------------------------
+
+  constexpr bool isLeapYear(int64_t y)
+  {
+    return y % 4 == 0 && (y % 100 != 0 || y % 400 == 0);
+  }
+  //----< number of days in month m, 1 - 12, of year y >---------------
+
+  constexpr unsigned daysInMonth(int64_t y, unsigned m)
+  {
+    constexpr unsigned char days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return (m == 2 && isLeapYear(y)) ? 29 : days[(m - 1) % 12];
+  }
+  //----< month number of a three letter English abbreviation >--------
+  /*
+   * Packs the three letters into one integer and switches on it,
+   * so lookup is a few compares with no hashing or string building.
+   */
+  constexpr unsigned monthFromName(std::string_view name)
+  {
+    if (name.size() != 3)
+      return 0;
+    constexpr auto key = [](char a, char b, char c) {
+      return (static_cast<uint32_t>(static_cast<unsigned char>(a)) << 16)
+           | (static_cast<uint32_t>(static_cast<unsigned char>(b)) << 8)
+           | static_cast<uint32_t>(static_cast<unsigned char>(c));
+    };
+    switch (key(name[0], name[1], name[2]))
+    {
+    case key('J', 'a', 'n'): return 1;
+    case key('F', 'e', 'b'): return 2;
+    case key('M', 'a', 'r'): return 3;
+    case key('A', 'p', 'r'): return 4;
+    case key('M', 'a', 'y'): return 5;
+    case key('J', 'u', 'n'): return 6;
+    case key('J', 'u', 'l'): return 7;
+    case key('A', 'u', 'g'): return 8;
+    case key('S', 'e', 'p'): return 9;
+    case key('O', 'c', 't'): return 10;
+    case key('N', 'o', 'v'): return 11;
+    case key('D', 'e', 'c'): return 12;
+    default: return 0;
+    }
+  }
+
+  static_assert(daysFromCivil(1970, 1, 1) == 0);
+  static_assert(daysFromCivil(2000, 3, 1) == 11017);
+  static_assert(civilFromDays(11017).year == 2000 && civilFromDays(11017).month == 3);
+  static_assert(monthFromName("Oct") == 10 && monthFromName("Foo") == 0);
+}
@@ -1,37 +1,218 @@
 /////////////////////////////////////////////////////////////////////
 // DateTime.cpp - represents clock time                            //
-// ver 1.1                                                         //
+// ver 1.3                                                         //
 // Jim Fawcett, CSE687 - Object Oriented Design, Spring 2017       //
 /////////////////////////////////////////////////////////////////////
 
 #include "DateTime.h"
+#include "CivilTime.h"
+#include "Stopwatch.h"
 #include <string>
 #include <iomanip>
 #include <sstream>
 #include <iostream>
-#include <unordered_map>
+#include <stdexcept>
+#include <cstdio>
+#include <cstring>
 #include <thread>
 
+#ifdef _MSC_VER
 #pragma warning(disable : 4267)  // disable warning about loss of significance
+#endif
 
 using namespace Utilities;
 
-//----< replaces std::ctime using ctime_s >--------------------------
-
-char* DateTime::ctime(const std::time_t* pTime)
+//----< reentrant replacement for std::localtime >-------------------
+/*
+ * Fills caller's result, like POSIX localtime_r, instead of a shared
+ * static buffer, so concurrent calls don't race.
+ * Returns nullptr if the time can't be converted.
+ */
+std::tm* DateTime::localtime(const std::time_t* pTime, std::tm* result)
 {
-  const rsize_t buffSize = 26;
-  static char buffer[buffSize];
-  errno_t err = ctime_s(buffer, buffSize, pTime);
-  return buffer;
+#ifdef _WIN32
+  if (localtime_s(result, pTime) != 0)
+    return nullptr;
+  return result;
+#else
+  return localtime_r(pTime, result);
+#endif
 }
-//----< replaces std::localtime using localtime_s >------------------
+//----< timestamp writers >------------------------------------------
+/*
+ * Digits are written directly, without snprintf or locales, and the
+ * per-thread cache keeps the last second's text, so consecutive stamps
+ * in the same second only patch their milliseconds.
+ */
+namespace
+{
+  using Format = DateTime::Format;
+
+  char* put2(char* p, int v)
+  {
+    p[0] = static_cast<char>('0' + v / 10);
+    p[1] = static_cast<char>('0' + v % 10);
+    return p + 2;
+  }
+  char* put3(char* p, int v)
+  {
+    p[0] = static_cast<char>('0' + v / 100);
+    return put2(p + 1, v % 100);
+  }
+  char* put4(char* p, int v)
+  {
+    return put2(put2(p, v / 100), v % 100);
+  }
+  /*-- seconds since epoch, and milliseconds past it, of tp --*/
+  std::time_t splitSeconds(const DateTime::TimePoint& tp, int& millis)
+  {
+    auto secs = std::chrono::floor<std::chrono::seconds>(tp);
+    millis = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(tp - secs).count());
+    return static_cast<std::time_t>(secs.time_since_epoch().count());
+  }
+  /*-- broken-down UTC time, computed without the C library --*/
+  std::tm utcTime(std::time_t t)
+  {
+    int64_t days = (t >= 0 ? t : t - 86399) / 86400;
+    int64_t rem = t - days * 86400;
+    CivilDate date = civilFromDays(days);
+    std::tm tm{};
+    tm.tm_year = static_cast<int>(date.year - 1900);
+    tm.tm_mon = static_cast<int>(date.month) - 1;
+    tm.tm_mday = static_cast<int>(date.day);
+    tm.tm_hour = static_cast<int>(rem / 3600);
+    tm.tm_min = static_cast<int>(rem / 60 % 60);
+    tm.tm_sec = static_cast<int>(rem % 60);
+    tm.tm_wday = static_cast<int>((days % 7 + 11) % 7);  // 1 Jan 1970 was a Thursday
+    return tm;
+  }
+  /*-- local time minus UTC, in seconds, for local time tm of t --*/
+  long utcOffset(const std::tm& tm, std::time_t t)
+  {
+    int64_t local = daysFromCivil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday) * 86400
+                  + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+    return static_cast<long>(local - t);
+  }
+  /*-- write stamp of tm into out, at least formatSize chars, returns length --*/
+  /*
+   * Returns 0 for years outside 0 - 9999, which don't fit the formats.
+   * fracPos is set to the index of the milliseconds, or 0 if none.
+   */
+  size_t writeStamp(char* out, const std::tm& tm, int millis, long offset, Format fmt, size_t& fracPos)
+  {
+    static const char days[7][4] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+    static const char months[12][4] = {
+      "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+    };
+    int year = tm.tm_year + 1900;
+    if (year < 0 || year > 9999)
+      return 0;
+    char* p = out;
+    fracPos = 0;
+    if (fmt == Format::ctime)
+    {
+      std::memcpy(p, days[tm.tm_wday], 3);
+      p[3] = ' ';
+      std::memcpy(p + 4, months[tm.tm_mon], 3);
+      p[7] = ' ';
+      p += 8;
+      if (tm.tm_mday < 10)
+      {
+        p[0] = ' ';
+        p[1] = static_cast<char>('0' + tm.tm_mday);
+        p += 2;
+      }
+      else
+      {
+        p = put2(p, tm.tm_mday);
+      }
+      *p++ = ' ';
+      p = put2(p, tm.tm_hour);
+      *p++ = ':';
+      p = put2(p, tm.tm_min);
+      *p++ = ':';
+      p = put2(p, tm.tm_sec);
+      *p++ = ' ';
+      if (year >= 1000)
+        p = put4(p, year);
+      else
+        p += std::snprintf(p, 5, "%d", year);
+    }
+    else
+    {
+      p = put4(p, year);
+      *p++ = '-';
+      p = put2(p, tm.tm_mon + 1);
+      *p++ = '-';
+      p = put2(p, tm.tm_mday);
+      *p++ = 'T';
+      p = put2(p, tm.tm_hour);
+      *p++ = ':';
+      p = put2(p, tm.tm_min);
+      *p++ = ':';
+      p = put2(p, tm.tm_sec);
+      *p++ = '.';
+      fracPos = static_cast<size_t>(p - out);
+      p = put3(p, millis);
+      if (fmt == Format::iso8601Utc)
+      {
+        *p++ = 'Z';
+      }
+      else
+      {
+        long abs = offset < 0 ? -offset : offset;
+        *p++ = offset < 0 ? '-' : '+';
+        p = put2(p, static_cast<int>(abs / 3600));
+        *p++ = ':';
+        p = put2(p, static_cast<int>(abs / 60 % 60));
+      }
+    }
+    *p = '\0';
+    return static_cast<size_t>(p - out);
+  }
+  /*-- copy stamp to caller's buffer if it fits, with null --*/
+  size_t copyOut(const char* stamp, size_t length, char* buffer, size_t size)
+  {
+    if (length == 0 || length >= size)
+      return 0;
+    std::memcpy(buffer, stamp, length + 1);
+    return length;
+  }
+  /*-- last stamp written by this thread --*/
+  struct StampCache
+  {
+    std::time_t second = 0;
+    Format fmt = Format::ctime;
+    bool valid = false;
+    size_t length = 0;
+    size_t fracPos = 0;
+    char text[DateTime::formatSize];
+  };
+  thread_local StampCache stampCache;
 
-std::tm* DateTime::localtime(const std::time_t* pTime)
+  /*-- ctime format into buffer, false if year or size out of range --*/
+  bool writeCtime(const std::tm& tm, char* buffer, size_t size)
+  {
+    char stamp[DateTime::formatSize];
+    size_t fracPos = 0;
+    size_t length = writeStamp(stamp, tm, 0, 0, Format::ctime, fracPos);
+    return copyOut(stamp, length, buffer, size) > 0;
+  }
+}
+//----< reentrant replacement for std::ctime >-----------------------
+/*
+ * Writes ctime's format, without its trailing newline, into caller's
+ * buffer of at least ctimeSize chars.
+ * Returns nullptr if buffer is too small or time can't be converted.
+ */
+char* DateTime::ctime(const std::time_t* pTime, char* buffer, size_t size)
 {
-  static std::tm result;
-  errno_t err = localtime_s(&result, pTime);
-  return &result;
+  std::tm tm;
+  if (size < ctimeSize || localtime(pTime, &tm) == nullptr)
+    return nullptr;
+  if (!writeCtime(tm, buffer, size))
+    return nullptr;
+  return buffer;
 }
 //----< construct DateTime instance with current system time >-------
 
@@ -40,51 +221,242 @@ DateTime::DateTime()
   tp_ = SysClock::now();
 }
 //----< construct DateTime from formatted time string >--------------
-/* 
- * Helper function that reads each part of the formatted string 
+/*
+ * Cursor is the fast parser's view of the remaining input.  It reads
+ * fixed fields in place, with no stream, locale, or allocation.
  */
-int readDateTimePart(int& part, std::istringstream& in)
+namespace
 {
-  if (in.peek() == ':')
-    in.get();
-  in >> part;
-  //std::cout << "\n  -- part = " << part << " --";
-  if (in.good())
-    return part;
-  return -1;
+  struct Cursor
+  {
+    const char* p;
+    const char* end;
+
+    bool done() const { return p == end; }
+    bool peekDigit() const { return p != end && *p >= '0' && *p <= '9'; }
+    bool peek(char ch) const { return p != end && *p == ch; }
+
+    /*-- consume ch if present --*/
+    bool accept(char ch)
+    {
+      if (!peek(ch))
+        return false;
+      ++p;
+      return true;
+    }
+    /*-- consume one or more spaces --*/
+    bool spaces()
+    {
+      if (!peek(' '))
+        return false;
+      while (peek(' '))
+        ++p;
+      return true;
+    }
+    /*-- read minDigits to maxDigits decimal digits --*/
+    bool number(int minDigits, int maxDigits, int& value)
+    {
+      int count = 0;
+      value = 0;
+      while (count < maxDigits && peekDigit())
+      {
+        value = 10 * value + (*p++ - '0');
+        ++count;
+      }
+      return count >= minDigits;
+    }
+    /*-- read n letters into a view --*/
+    bool letters(size_t n, std::string_view& word)
+    {
+      if (static_cast<size_t>(end - p) < n)
+        return false;
+      word = std::string_view(p, n);
+      for (char ch : word)
+      {
+        if (!((ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z')))
+          return false;
+      }
+      p += n;
+      return true;
+    }
+    /*-- only trailing whitespace left, as after ctime's newline --*/
+    bool atEnd()
+    {
+      while (p != end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+        ++p;
+      return p == end;
+    }
+  };
+
+  struct Parts
+  {
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    long nanos = 0;
+    bool hasZone = false;
+    int offsetSeconds = 0;  // local time minus UTC, when hasZone
+  };
+
+  using ParseError = DateTime::ParseError;
+
+  /*-- hh:mm:ss --*/
+  ParseError parseClock(Cursor& in, Parts& parts)
+  {
+    if (!in.number(1, 2, parts.hour) || !in.accept(':') ||
+        !in.number(2, 2, parts.minute) || !in.accept(':') ||
+        !in.number(2, 2, parts.second))
+      return ParseError::badTime;
+    if (parts.hour > 23 || parts.minute > 59 || parts.second > 60)
+      return ParseError::badTime;
+    return ParseError::none;
+  }
+  /*-- Www Mmm dd hh:mm:ss yyyy --*/
+  ParseError parseCtime(Cursor& in, Parts& parts)
+  {
+    std::string_view word;
+    if (!in.letters(3, word) || !in.spaces() || !in.letters(3, word))
+      return ParseError::badFormat;
+    parts.month = static_cast<int>(monthFromName(word));
+    if (parts.month == 0)
+      return ParseError::badMonth;
+    if (!in.spaces() || !in.number(1, 2, parts.day) || !in.spaces())
+      return ParseError::badDate;
+    ParseError err = parseClock(in, parts);
+    if (err != ParseError::none)
+      return err;
+    if (!in.spaces() || !in.number(4, 4, parts.year))
+      return ParseError::badDate;
+    return ParseError::none;
+  }
+  /*-- yyyy-mm-dd[Thh:mm:ss[.fff]][Z|+hh:mm|-hh:mm] --*/
+  ParseError parseIso(Cursor& in, Parts& parts)
+  {
+    if (!in.number(4, 4, parts.year) || !in.accept('-') ||
+        !in.number(2, 2, parts.month) || !in.accept('-') ||
+        !in.number(2, 2, parts.day))
+      return ParseError::badDate;
+    if (parts.month < 1 || parts.month > 12)
+      return ParseError::badMonth;
+    if (!in.accept('T') && !in.accept(' '))
+      return ParseError::none;  // date only, midnight
+    ParseError err = parseClock(in, parts);
+    if (err != ParseError::none)
+      return err;
+    if (in.accept('.') || in.accept(','))
+    {
+      long scale = 100000000;
+      if (!in.peekDigit())
+        return ParseError::badTime;
+      for (; in.peekDigit(); ++in.p, scale /= 10)
+        parts.nanos += (*in.p - '0') * scale;
+    }
+    if (in.accept('Z'))
+    {
+      parts.hasZone = true;
+    }
+    else if (in.peek('+') || in.peek('-'))
+    {
+      int sign = (*in.p++ == '-') ? -1 : 1;
+      int hh = 0, mm = 0;
+      if (!in.number(2, 2, hh))
+        return ParseError::badZone;
+      in.accept(':');
+      if (in.peekDigit() && !in.number(2, 2, mm))
+        return ParseError::badZone;
+      if (hh > 23 || mm > 59)
+        return ParseError::badZone;
+      parts.hasZone = true;
+      parts.offsetSeconds = sign * (3600 * hh + 60 * mm);
+    }
+    return ParseError::none;
+  }
+
+  /*-- can a TimePoint hold secs plus a fraction of a second --*/
+  bool fitsTimePoint(int64_t secs)
+  {
+    using std::chrono::duration_cast;
+    using std::chrono::seconds;
+    using TimePoint = DateTime::TimePoint;
+    // casts truncate toward zero, so both bounds are inside the range
+    int64_t first = duration_cast<seconds>(TimePoint::min().time_since_epoch()).count();
+    int64_t last = duration_cast<seconds>(TimePoint::max().time_since_epoch()).count();
+    return first <= secs && secs < last;
+  }
 }
-//----< makes a DateTime instance from a formatted string >----------
+//----< parse ctime or ISO-8601 string, without exceptions >---------
 /*
-*  Throws exception if string is an invalid DateTime string
-*/
-DateTime::DateTime(std::string dtStr)
+ * Accepts "Www Mmm dd hh:mm:ss yyyy", as time() and ctime write, and
+ * "yyyy-mm-dd[Thh:mm:ss[.fff][Z|+hh:mm]]".  Strings with no zone are
+ * read as local time, using mktime, or as UTC if zone is Zone::utc.
+ * UTC results are computed directly, with no C library calls.
+ * On error returns the reason and leaves tp unchanged.
+ */
+DateTime::ParseError DateTime::parse(std::string_view str, TimePoint& tp, Zone zone)
 {
-  static std::unordered_map<std::string, size_t> months = {
-    { "Jan", 1 }, { "Feb", 2 }, { "Mar", 3 }, { "Apr", 4 }, 
-    { "May", 5 }, { "Jun", 6 }, { "Jul", 7 }, { "Aug", 8 }, 
-    { "Sep", 9 }, { "Oct", 10 }, { "Nov", 11 }, { "Dec", 12 } 
-  };
-  std::istringstream in(dtStr);
-  std::string day, month;
-  in >> day;
-  in >> month;
-  if (!in.good())
-    throw std::exception("invalid DateTime string");
-  std::tm date;
-  date.tm_mon = months[month] - 1;
-  readDateTimePart(date.tm_mday, in);
-  readDateTimePart(date.tm_hour, in);
-  readDateTimePart(date.tm_min, in);
-  readDateTimePart(date.tm_sec, in);
-  readDateTimePart(date.tm_year, in);
-  date.tm_year -= 1900;
+  Cursor in{ str.data(), str.data() + str.size() };
+  while (in.peek(' '))
+    ++in.p;
+  if (in.done())
+    return ParseError::badFormat;
+
+  Parts parts;
+  ParseError err = in.peekDigit() ? parseIso(in, parts) : parseCtime(in, parts);
+  if (err != ParseError::none)
+    return err;
+  if (!in.atEnd())
+    return ParseError::badFormat;
+  if (parts.day < 1 || parts.day > static_cast<int>(daysInMonth(parts.year, parts.month)))
+    return ParseError::badDate;
+
+  std::chrono::nanoseconds frac(parts.nanos);
+  if (parts.hasZone || zone == Zone::utc)
+  {
+    int64_t days = daysFromCivil(parts.year, parts.month, parts.day);
+    int64_t secs = days * 86400 + parts.hour * 3600 + parts.minute * 60 + parts.second
+                 - parts.offsetSeconds;
+    if (!fitsTimePoint(secs))
+      return ParseError::outOfRange;
+    tp = TimePoint(std::chrono::duration_cast<Duration>(std::chrono::seconds(secs) + frac));
+    return ParseError::none;
+  }
+  std::tm date{};
+  date.tm_year = parts.year - 1900;
+  date.tm_mon = parts.month - 1;
+  date.tm_mday = parts.day;
+  date.tm_hour = parts.hour;
+  date.tm_min = parts.minute;
+  date.tm_sec = parts.second;
   date.tm_isdst = -1;
   std::time_t time = std::mktime(&date);
-  if (time == -1)
+  if (time == -1 || !fitsTimePoint(static_cast<int64_t>(time)))
+    return ParseError::outOfRange;
+  tp = SysClock::from_time_t(time) + std::chrono::duration_cast<Duration>(frac);
+  return ParseError::none;
+}
+//----< display name of parse error >--------------------------------
+
+const char* DateTime::parseErrorName(ParseError err)
+{
+  switch (err)
   {
-    throw "invalid system time";
+  case ParseError::none: return "none";
+  case ParseError::badFormat: return "bad format";
+  case ParseError::badMonth: return "bad month";
+  case ParseError::badDate: return "bad date";
+  case ParseError::badTime: return "bad time";
+  case ParseError::badZone: return "bad time zone";
+  case ParseError::outOfRange: return "out of range";
   }
-  tp_ = SysClock::from_time_t(time);  
+  return "unknown";
+}
+//----< makes a DateTime instance from a formatted string >----------
+/*
+*  Throws exception if string is an invalid DateTime string
+*/
+DateTime::DateTime(std::string dtStr)
+{
+  ParseError err = parse(dtStr, tp_);
+  if (err != ParseError::none)
+    throw std::invalid_argument(std::string("invalid DateTime string: ") + parseErrorName(err));
 }
 //----< cast operator converts to time formatted string >------------
 
@@ -136,9 +508,77 @@ std::string DateTime::now()
 {
   TimePoint tp = SysClock::now();
   std::time_t t = SysClock::to_time_t(tp);
-  std::string ts = ctime(&t);
-  ts.resize(ts.size() - 1);
-  return ts;
+  char buffer[ctimeSize];
+  if (ctime(&t, buffer, ctimeSize) == nullptr)
+    return std::string();
+  return buffer;
+}
+//----< write timestamp into buffer, returns length or 0 if too small >---
+/*
+ * Writes a null terminated stamp, with no allocation.  The broken-down
+ * time goes in a local, not the instance's cache, so threads may format
+ * one shared const DateTime at once.
+ */
+size_t DateTime::formatTo(char* buffer, size_t size, Format fmt) const
+{
+  int millis = 0;
+  std::time_t t = splitSeconds(tp_, millis);
+  char stamp[formatSize];
+  size_t fracPos = 0;
+  size_t length = 0;
+  if (fmt == Format::iso8601Utc)
+  {
+    length = writeStamp(stamp, utcTime(t), millis, 0, fmt, fracPos);
+  }
+  else
+  {
+    std::tm tm{};
+    if (localtime(&t, &tm) == nullptr)
+      return 0;
+    length = writeStamp(stamp, tm, millis, utcOffset(tm, t), fmt, fracPos);
+  }
+  return copyOut(stamp, length, buffer, size);
+}
+//----< write timestamp of tp, reusing this thread's last second >---
+/*
+ * Consecutive calls on one thread for the same second copy the cached
+ * text and patch the milliseconds, skipping the time zone conversion.
+ */
+size_t DateTime::formatTimePoint(const TimePoint& tp, char* buffer, size_t size, Format fmt)
+{
+  int millis = 0;
+  std::time_t t = splitSeconds(tp, millis);
+  StampCache& cache = stampCache;
+  if (!cache.valid || cache.second != t || cache.fmt != fmt)
+  {
+    std::tm tm{};
+    long offset = 0;
+    if (fmt == Format::iso8601Utc)
+    {
+      tm = utcTime(t);
+    }
+    else
+    {
+      if (localtime(&t, &tm) == nullptr)
+        return 0;
+      offset = utcOffset(tm, t);
+    }
+    cache.length = writeStamp(cache.text, tm, millis, offset, fmt, cache.fracPos);
+    cache.second = t;
+    cache.fmt = fmt;
+    cache.valid = cache.length > 0;
+  }
+  else if (cache.fracPos > 0)
+  {
+    put3(cache.text + cache.fracPos, millis);
+  }
+  return copyOut(cache.text, cache.length, buffer, size);
+}
+//----< write timestamp of current time >----------------------------
+
+size_t DateTime::formatNow(char* buffer, size_t size, Format fmt)
+{
+  return formatTimePoint(SysClock::now(), buffer, size, fmt);
 }
 //----< return internal time point >---------------------------------
 
@@ -157,10 +597,10 @@ size_t DateTime::ticks()
 
 std::string DateTime::time()
 {
-  std::time_t t = SysClock::to_time_t(tp_);
-  std::string ts = ctime(&t);
-  ts.resize(ts.size() - 1);
-  return ts;
+  char buffer[ctimeSize];
+  if (!writeCtime(brokenDown(), buffer, ctimeSize))
+    return std::string();
+  return buffer;
 }
 //----< compare DateTime instances >---------------------------------
 
@@ -203,6 +643,7 @@ bool DateTime::operator>=(const DateTime& dt)
 DateTime DateTime::operator+=(const DateTime::Duration& dur)
 {
   tp_ += dur;
+  tmValid_ = false;
   return *this;
 }
 //----< make DateTime from instance time plus duration >-------------
@@ -217,6 +658,7 @@ DateTime DateTime::operator+(const DateTime::Duration& dur)
 DateTime DateTime::operator-=(const DateTime::Duration& dur)
 {
   tp_ -= dur;
+  tmValid_ = false;
   return *this;
 }
 //----< make DateTime from instance time minus duration >------------
@@ -225,9 +667,26 @@ DateTime DateTime::operator-(const DateTime::Duration& dur)
 {
   return DateTime(tp_ - dur);
 }
-//----< start timer >------------------------------------------------
+//----< tick source reading HiResClock, for clock calibration >-----
+
+namespace
+{
+  struct HiResTicks
+  {
+    static uint64_t now()
+    {
+      auto since = DateTime::HiResClock::now().time_since_epoch();
+      return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(since).count());
+    }
+    static uint64_t start() { return now(); }
+    static uint64_t stop() { return now(); }
+    static double nanosecondsPerTick() { return 1.0; }
+  };
+}
+//----< start timer, calibrating the clock on first use >------------
 
 void DateTime::start() {
+  clockCalibration<HiResTicks>();
   start_ = HiResClock::now();
   running_ = true;
 }
@@ -237,8 +696,11 @@ void DateTime::stop() {
   end_ = HiResClock::now();
   running_ = false;
 }
-//----< return duration in microseconds >----------------------------
-
+//----< return duration in microseconds, less clock read cost >-----
+/*
+ * Fractional, not truncated to whole microseconds, so the overhead
+ * subtraction survives for short intervals.
+ */
 double DateTime::elapsedMicroseconds() {
   HiResTimePoint endTime;
   if (running_) {
@@ -247,63 +709,77 @@ double DateTime::elapsedMicroseconds() {
   else {
     endTime = end_;
   }
-  auto duration = std::chrono::duration_cast<std::chrono::microseconds> (
-    endTime - start_
-    ).count();
-  return static_cast<double>(duration);
+  double nanos = std::chrono::duration<double, std::nano>(endTime - start_).count()
+               - clockCalibration<HiResTicks>().overheadNs;
+  return nanos > 0.0 ? nanos / 1000.0 : 0.0;
 }
 //----< return duration in milliseconds >----------------------------
 
 double DateTime::elapsedMilliseconds() {
   return elapsedMicroseconds() / 1000.0;
 }
+//----< local time of tp_, computed on first use >------------------
+/*
+ * Non-const, as it fills the cache, so const paths can't race on it.
+ */
+const std::tm& DateTime::brokenDown()
+{
+  if (!tmValid_)
+  {
+    int millis = 0;
+    std::time_t t = splitSeconds(tp_, millis);  // floor, also before 1970
+    if (localtime(&t, &tm_) == nullptr)
+      tm_ = std::tm{};
+    tmValid_ = true;
+  }
+  return tm_;
+}
 //----< return year count >------------------------------------------
 
 size_t DateTime::year()
 {
-  std::time_t t = SysClock::to_time_t(tp_);
-  std::tm tm = *localtime(&t);
-  return tm.tm_year;
+  return brokenDown().tm_year;
 }
 //----< return month count >-----------------------------------------
 
 size_t DateTime::month()
 {
-  std::time_t t = SysClock::to_time_t(tp_);
-  std::tm tm = *localtime(&t);
-  return tm.tm_mon;
+  return brokenDown().tm_mon;
 }
 //----< return day count >-------------------------------------------
 
 size_t DateTime::day()
 {
-  std::time_t t = SysClock::to_time_t(tp_);
-  std::tm tm = *localtime(&t);
-  return tm.tm_mday;
+  return brokenDown().tm_mday;
 }
 //----< return hour count >------------------------------------------
 
 size_t DateTime::hour()
 {
-  std::time_t t = SysClock::to_time_t(tp_);
-  std::tm tm = *localtime(&t);
-  return tm.tm_hour;
+  return brokenDown().tm_hour;
 }
 //----< return minutes count >---------------------------------------
 
 size_t DateTime::minute()
 {
-  std::time_t t = SysClock::to_time_t(tp_);
-  std::tm tm = *localtime(&t);
-  return tm.tm_min;
+  return brokenDown().tm_min;
 }
 //----< return seconds count >---------------------------------------
 
 size_t DateTime::second()
 {
-  std::time_t t = SysClock::to_time_t(tp_);
-  std::tm tm = *localtime(&t);
-  return tm.tm_sec;
+  return brokenDown().tm_sec;
+}
+//----< return all counts with one time conversion >-----------------
+
+DateTime::Fields DateTime::fields()
+{
+  const std::tm& tm = brokenDown();
+  return Fields{
+    static_cast<size_t>(tm.tm_year), static_cast<size_t>(tm.tm_mon),
+    static_cast<size_t>(tm.tm_mday), static_cast<size_t>(tm.tm_hour),
+    static_cast<size_t>(tm.tm_min), static_cast<size_t>(tm.tm_sec)
+  };
 }
 
 //----< test stub >--------------------------------------------------
@@ -311,8 +787,57 @@ size_t DateTime::second()
 #ifdef TEST_DATETIME
 
 #include <iostream>
+#include <vector>
+#include <atomic>
 #include "StringUtilities.h"
 
+/*----------------------------------------------------------------
+  Formats the same time points on many threads at once, and one
+  shared const DateTime from all of them, and checks every result
+  against a single threaded pass.  Build with
+  -fsanitize=thread to have ThreadSanitizer check for data races.
+*/
+size_t stressFormatting(size_t threadCount, size_t iterations)
+{
+  std::vector<DateTime::TimePoint> points;
+  std::vector<std::string> expected;
+  DateTime::TimePoint base = DateTime::SysClock::now();
+  for (size_t i = 0; i < 64; ++i)
+  {
+    points.push_back(base + std::chrono::hours(7 * i) + std::chrono::seconds(13 * i));
+    DateTime dt(points.back());
+    expected.push_back(dt.time() + " " + std::to_string(dt.year()) + std::to_string(dt.second()));
+  }
+  /* one const instance formatted by every thread, with no copies */
+  const DateTime shared(points[5]);
+  char sharedCtime[DateTime::formatSize], sharedIso[DateTime::formatSize];
+  shared.formatTo(sharedCtime, sizeof(sharedCtime));
+  shared.formatTo(sharedIso, sizeof(sharedIso), DateTime::Format::iso8601);
+
+  std::atomic<size_t> mismatches{ 0 };
+  auto work = [&](size_t id) {
+    for (size_t i = 0; i < iterations; ++i)
+    {
+      size_t k = (i + id) % points.size();
+      DateTime dt(points[k]);
+      std::string result = dt.time() + " " + std::to_string(dt.year()) + std::to_string(dt.second());
+      if (result != expected[k])
+        ++mismatches;
+      char stamp[DateTime::formatSize];
+      shared.formatTo(stamp, sizeof(stamp), i % 2 ? DateTime::Format::iso8601 : DateTime::Format::ctime);
+      if (std::string(stamp) != (i % 2 ? sharedIso : sharedCtime))
+        ++mismatches;
+      DateTime().now();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t id = 0; id < threadCount; ++id)
+    threads.emplace_back(work, id);
+  for (auto& thread : threads)
+    thread.join();
+  return mismatches.load();
+}
+
 int main()
 {
   Utilities::Title("Testing DateTime class");
@@ -332,7 +857,26 @@ int main()
     else
       std::cout << "\n  " << now.time() << " is not less than " << dt.time();
     std::cout << "\n  now.ticks() = " << now.ticks();
-    std::cout << "\n  constructing DateTime from formated DateTime string";
+    DateTime::Fields f = now.fields();
+    std::cout << "\n  now.fields() = " << f.year + 1900 << "/" << f.month + 1 << "/" << f.day
+              << " " << f.hour << ":" << f.minute << ":" << f.second;
+    char stamp[DateTime::formatSize];
+    now.formatTo(stamp, sizeof(stamp), DateTime::Format::iso8601);
+    std::cout << "\n  now.formatTo(ISO-8601) = " << stamp;
+    DateTime::formatNow(stamp, sizeof(stamp), DateTime::Format::iso8601Utc);
+    std::cout << "\n  formatNow(ISO-8601 UTC) = " << stamp;
+    std::cout << "\n\n  parsing ISO-8601 strings, last two beyond system_clock's range:";
+    for (const char* text : { "2026-10-17T11:35:24.123Z", "9999-12-31T00:00:00Z", "1600-01-01T00:00:00Z" })
+    {
+      DateTime::TimePoint tp{};
+      DateTime::ParseError err = DateTime::parse(text, tp);
+      std::cout << "\n  " << text << " -> " << DateTime::parseErrorName(err);
+    }
+    DateTime::TimePoint localTp{};
+    std::cout << "\n  2300-01-01T00:00:00 local -> "
+              << DateTime::parseErrorName(DateTime::parse("2300-01-01T00:00:00", localTp));
+    std::cout << "\n  unchanged on error: " << (localTp == DateTime::TimePoint{} ? "yes" : "no");
+    std::cout << "\n\n  constructing DateTime from formated DateTime string";
     DateTime newDt(dt.time());
     std::cout << "\n  " << newDt.time();
 
@@ -344,6 +888,10 @@ int main()
     std::cout << "\n  sleep for 150 millisecs";
     std::this_thread::sleep_for(std::chrono::milliseconds(150));
     std::cout << "\n  duration in microsecs: " << dt.elapsedMicroseconds();
+
+    std::cout << "\n\n  formatting on 8 threads, 20000 times each";
+    size_t mismatches = stressFormatting(8, 20000);
+    std::cout << "\n  " << mismatches << " results differ from single threaded formatting";
   }
   catch (std::exception& ex)
   {
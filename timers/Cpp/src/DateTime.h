@@ -1,7 +1,7 @@
 #pragma once
 /////////////////////////////////////////////////////////////////////
 // DateTime.h - represents clock time                              //
-// ver 1.1                                                         //
+// ver 1.3                                                         //
 // Jim Fawcett, CSE687 - Object Oriented Design, Spring 2017       //
 /////////////////////////////////////////////////////////////////////
 /*
@@ -9,18 +9,35 @@
  * -------------------
  * The DateTime class represents clock time, and supports:
  * - creating default instances and instances from specific time points
- * - return times as formatted strings
+ * - parsing ctime and ISO-8601 strings, reporting errors without throwing
+ * - return times as formatted strings, or write them into caller buffers
+ *   with no allocation, optionally through a per-thread cache
  * - building time points and durations from years, months, days, hours, ...
  * - performing addition and subtraction of times
  * - comparing times
- * - extracting counts of years, months, days, hours, minutes, and seconds
+ * - extracting counts of years, months, days, hours, minutes, and seconds,
+ *   individually or all at once with fields()
+ * The broken-down local time is computed once, on first use of any of
+ * the count accessors, and reused until the time point changes.
  *
  * Required Files:
  * ---------------
- *   DateTime.h, DateTime.cpp
+ *   DateTime.h, DateTime.cpp, CivilTime.h, Stopwatch.h
  *
  * Maintenance History:
  * --------------------
+ * ver 1.3 : 17 Oct 2026
+ * - elapsedMicroseconds subtracts the calibrated cost of reading the
+ *   clock, and reports fractional microseconds
+ * ver 1.2 : 17 Oct 2026
+ * - ctime and localtime write to caller buffers, using localtime_r or
+ *   localtime_s, so all formatting is safe to call from many threads
+ * - builds with gcc and clang as well as Visual Studio
+ * - caches broken-down time fields, added fields() bulk accessor
+ * - added parse, a fast ctime and ISO-8601 parser used by the string
+ *   constructor, which no longer uses istringstream
+ * - added formatTo, formatTimePoint, and formatNow, which write ctime or
+ *   ISO-8601 timestamps into caller buffers
  * ver 1.1 : 10 Feb 2018
  * - added operator==, operator!=, operator<=, and operator>=
  * ver 1.0 : 18 Feb 2018
@@ -29,7 +46,9 @@
 
 #include <chrono>
 #include <ctime>
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace Utilities
 {
@@ -42,6 +61,26 @@ namespace Utilities
     using HiResTimePoint = HiResClock::time_point;
     using Duration = std::chrono::system_clock::duration;
 
+    // same values as the year() ... second() accessors
+    struct Fields
+    {
+      size_t year;    // years since 1900
+      size_t month;   // 0 - 11
+      size_t day;     // 1 - 31
+      size_t hour;    // 0 - 23
+      size_t minute;  // 0 - 59
+      size_t second;  // 0 - 60
+    };
+
+    enum class ParseError { none, badFormat, badMonth, badDate, badTime, badZone, outOfRange };
+    enum class Zone { local, utc };  // zone of strings that don't name one
+
+    // ctime:      Sat Oct 17 11:35:24 2026         local time
+    // iso8601:    2026-10-17T11:35:24.123+02:00    local time, with offset
+    // iso8601Utc: 2026-10-17T09:35:24.123Z         UTC
+    enum class Format { ctime, iso8601, iso8601Utc };
+    static constexpr size_t formatSize = 32;  // holds any Format, with null
+
     DateTime();
     DateTime(std::string dtStr);
     DateTime(const TimePoint& tp);
@@ -52,6 +91,13 @@ namespace Utilities
     double elapsedMicroseconds();
     double elapsedMilliseconds();
 
+    static ParseError parse(std::string_view str, TimePoint& tp, Zone zone = Zone::local);
+    static const char* parseErrorName(ParseError err);
+
+    size_t formatTo(char* buffer, size_t size, Format fmt = Format::ctime) const;
+    static size_t formatTimePoint(const TimePoint& tp, char* buffer, size_t size, Format fmt = Format::ctime);
+    static size_t formatNow(char* buffer, size_t size, Format fmt = Format::ctime);
+
     std::string now();
     TimePoint timepoint();
     size_t ticks();
@@ -81,12 +127,58 @@ namespace Utilities
     size_t hour();
     size_t minute();
     size_t second();
-    char* ctime(const std::time_t* pTime);
-    std::tm* localtime(const time_t* pTime);
+    Fields fields();
+    static constexpr size_t ctimeSize = 26;
+    static char* ctime(const std::time_t* pTime, char* buffer, size_t size);
+    static std::tm* localtime(const std::time_t* pTime, std::tm* result);
   private:
+    const std::tm& brokenDown();
+
     TimePoint tp_;
+    std::tm tm_{};          // local time of tp_, valid if tmValid_
+    bool tmValid_ = false;
     HiResTimePoint start_;
     HiResTimePoint end_;
     bool running_ = false;
   };
-}
\ No newline at end of file
+}
+
+#include <version>
+#if defined(__cpp_lib_format)
+#include <format>
+#include <algorithm>
+
+/////////////////////////////////////////////////////////////////////
+// std::format support, writing through DateTime::formatTo
+// - {} or {:c} ctime, {:i} ISO-8601 local time, {:u} ISO-8601 UTC
+
+template <>
+struct std::formatter<Utilities::DateTime, char>
+{
+  Utilities::DateTime::Format fmt = Utilities::DateTime::Format::ctime;
+
+  constexpr auto parse(std::format_parse_context& ctx)
+  {
+    auto it = ctx.begin();
+    if (it != ctx.end() && *it != '}')
+    {
+      switch (*it++)
+      {
+      case 'c': fmt = Utilities::DateTime::Format::ctime; break;
+      case 'i': fmt = Utilities::DateTime::Format::iso8601; break;
+      case 'u': fmt = Utilities::DateTime::Format::iso8601Utc; break;
+      default: throw std::format_error("invalid DateTime format");
+      }
+    }
+    if (it != ctx.end() && *it != '}')
+      throw std::format_error("invalid DateTime format");
+    return it;
+  }
+  auto format(const Utilities::DateTime& dt, std::format_context& ctx) const
+  {
+    char buffer[Utilities::DateTime::formatSize];
+    size_t length = dt.formatTo(buffer, sizeof(buffer), fmt);
+    return std::copy(buffer, buffer + length, ctx.out());
+  }
+};
+#endif
@@ -0,0 +1,228 @@
+/////////////////////////////////////////////////////////////////////
+// DateTimeBatch.cpp - convert columns of time points to calendar  //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+
+#include "DateTimeBatch.h"
+#include "CivilTime.h"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace Utilities;
+
+namespace
+{
+  constexpr size_t blockSize = 1024;
+  constexpr std::time_t maxStep = 128 * 3600;     // probe spacing, 128 hours
+  constexpr std::time_t maxWindow = 400 * 86400;  // zones without daylight saving
+
+  /*-- local time minus UTC, in seconds, at t --*/
+  long offsetOf(std::time_t t)
+  {
+    std::tm tm;
+    if (DateTime::localtime(&t, &tm) == nullptr)
+      return 0;
+    int64_t local = daysFromCivil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday) * 86400
+                  + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+    return static_cast<long>(local - t);
+  }
+  /*-- throws unless every column holds count values --*/
+  void checkColumns(const CalendarColumns& columns, size_t count)
+  {
+    size_t smallest = std::min({
+      columns.year.size(), columns.month.size(), columns.day.size(),
+      columns.hour.size(), columns.minute.size(), columns.second.size()
+    });
+    if (smallest < count)
+      throw std::invalid_argument("CalendarColumns smaller than time point span");
+  }
+  /*-- fields of one block, from days since epoch and seconds of day --*/
+  /*
+   * civilFromDays narrowed to 32 bit arithmetic, which SSE2 and AVX2
+   * divide by constants with multiplies, so the loop vectorizes.
+   * Days are shifted to a 400 year era boundary before 1970, so
+   * every quotient is of a non-negative value.  Columns never
+   * overlap, and __restrict saves the vectorizer checking each pair.
+   */
+  void fillBlock(
+    const int32_t* __restrict days, const int32_t* __restrict secs, size_t count,
+    int32_t* __restrict year, int32_t* __restrict month, int32_t* __restrict day,
+    int32_t* __restrict hour, int32_t* __restrict minute, int32_t* __restrict second
+  )
+  {
+    constexpr int32_t eraShift = 146097 * 100;  // 40000 years, covers any TimePoint
+    for (size_t i = 0; i < count; ++i)
+    {
+      const uint32_t z = static_cast<uint32_t>(days[i] + 719468 + eraShift);
+      const uint32_t era = z / 146097;
+      const uint32_t doe = z - era * 146097;
+      const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+      const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+      const uint32_t mp = (5 * doy + 2) / 153;
+      const uint32_t m = mp < 10 ? mp + 3 : mp - 9;
+      year[i] = static_cast<int32_t>(yoe + era * 400) - 40000 + (m <= 2);
+      month[i] = static_cast<int32_t>(m);
+      day[i] = static_cast<int32_t>(doy - (153 * mp + 2) / 5 + 1);
+
+      const uint32_t s = static_cast<uint32_t>(secs[i]);
+      hour[i] = static_cast<int32_t>(s / 3600);
+      minute[i] = static_cast<int32_t>(s / 60 % 60);
+      second[i] = static_cast<int32_t>(s % 60);
+    }
+  }
+  /*-- split seconds since epoch into days and seconds of day --*/
+  inline void splitDay(int64_t t, int32_t& days, int32_t& secs)
+  {
+    int64_t d = (t >= 0 ? t : t - 86399) / 86400;
+    days = static_cast<int32_t>(d);
+    secs = static_cast<int32_t>(t - d * 86400);
+  }
+  inline std::time_t floorSeconds(const DateTime::TimePoint& tp)
+  {
+    return static_cast<std::time_t>(
+      std::chrono::floor<std::chrono::seconds>(tp).time_since_epoch().count()
+    );
+  }
+  /*-- convert points in blocks, offset(t) gives seconds to add to t --*/
+  template <typename Offset>
+  void toCalendar(std::span<const DateTime::TimePoint> points, const CalendarColumns& columns, Offset offset)
+  {
+    checkColumns(columns, points.size());
+    int32_t days[blockSize];
+    int32_t secs[blockSize];
+    for (size_t first = 0; first < points.size(); first += blockSize)
+    {
+      size_t count = std::min(blockSize, points.size() - first);
+      for (size_t i = 0; i < count; ++i)
+      {
+        std::time_t t = floorSeconds(points[first + i]);
+        splitDay(t + offset(t), days[i], secs[i]);
+      }
+      fillBlock(
+        days, secs, count,
+        columns.year.data() + first, columns.month.data() + first, columns.day.data() + first,
+        columns.hour.data() + first, columns.minute.data() + first, columns.second.data() + first
+      );
+    }
+  }
+}
+//----< find the daylight saving window around t >------------------
+/*
+ * Steps out from t in both directions, doubling the step from one hour
+ * up to maxStep, until localtime reports another offset, then bisects
+ * to the second of the transition.  About 80 localtime calls.
+ */
+void UtcOffsetCache::load(std::time_t t)
+{
+  ++loads_;
+  const long offset = offsetOf(t);
+  auto bisect = [offset](std::time_t same, std::time_t other) {
+    while (same + 1 != other && same - 1 != other)
+    {
+      std::time_t mid = same + (other - same) / 2;
+      (offsetOf(mid) == offset ? same : other) = mid;
+    }
+    return same;  // last second with offset
+  };
+  auto reach = [&](std::time_t direction) {
+    std::time_t same = t;
+    std::time_t step = 3600;
+    std::time_t limit = t + direction * maxWindow;
+    while (same != limit)
+    {
+      std::time_t probe = direction > 0 ? std::min(same + step, limit) : std::max(same - step, limit);
+      if (offsetOf(probe) != offset)
+        return bisect(same, probe);
+      same = probe;
+      step = std::min(step * 2, maxStep);
+    }
+    return same;
+  };
+  Window& window = windows_[1];
+  window.offset = offset;
+  window.begin = reach(-1);
+  window.end = reach(1) + 1;
+}
+//----< UTC calendar fields of points >------------------------------
+
+void Utilities::toCalendarUtc(std::span<const DateTime::TimePoint> points, const CalendarColumns& columns)
+{
+  toCalendar(points, columns, [](std::time_t) { return 0L; });
+}
+//----< local calendar fields of points >----------------------------
+
+void Utilities::toCalendarLocal(
+  std::span<const DateTime::TimePoint> points, const CalendarColumns& columns, UtcOffsetCache& offsets
+)
+{
+  toCalendar(points, columns, [&offsets](std::time_t t) { return offsets.offsetAt(t); });
+}
+//----< local calendar fields of points, with a fresh offset cache >-
+
+void Utilities::toCalendarLocal(std::span<const DateTime::TimePoint> points, const CalendarColumns& columns)
+{
+  UtcOffsetCache offsets;
+  toCalendarLocal(points, columns, offsets);
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_DATETIMEBATCH
+
+#include <iostream>
+#include <vector>
+#include "StringUtilities.h"
+
+/*-- count of points whose columns differ from localtime or gmtime --*/
+size_t mismatches(const std::vector<DateTime::TimePoint>& points, bool local)
+{
+  size_t n = points.size();
+  std::vector<int32_t> y(n), mo(n), d(n), h(n), mi(n), s(n);
+  CalendarColumns columns{ y, mo, d, h, mi, s };
+  UtcOffsetCache offsets;
+  if (local)
+    toCalendarLocal(points, columns, offsets);
+  else
+    toCalendarUtc(points, columns);
+
+  size_t bad = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    std::time_t t = floorSeconds(points[i]);
+    std::tm tm;
+    if (local)
+      DateTime::localtime(&t, &tm);
+    else
+      tm = *std::gmtime(&t);
+    if (y[i] != tm.tm_year + 1900 || mo[i] != tm.tm_mon + 1 || d[i] != tm.tm_mday
+      || h[i] != tm.tm_hour || mi[i] != tm.tm_min || s[i] != tm.tm_sec)
+      ++bad;
+  }
+  if (local)
+    std::cout << "\n  offset windows loaded: " << offsets.loads();
+  return bad;
+}
+
+int main()
+{
+  Utilities::Title("Testing DateTimeBatch");
+
+  std::vector<DateTime::TimePoint> points;
+  DateTime::TimePoint base = DateTime::SysClock::now() - std::chrono::hours(24 * 365 * 60);
+  for (size_t i = 0; i < 200000; ++i)
+    points.push_back(base + std::chrono::milliseconds(20011037LL * i));  // 120 years
+
+  size_t utc = mismatches(points, false);
+  size_t local = mismatches(points, true);
+  std::cout << "\n  UTC mismatches:   " << utc;
+  std::cout << "\n  local mismatches: " << local;
+
+  std::vector<DateTime::TimePoint> one{ DateTime::SysClock::now() };
+  int32_t y, mo, d, h, mi, s;
+  toCalendarLocal(one, CalendarColumns{ { &y, 1 }, { &mo, 1 }, { &d, 1 }, { &h, 1 }, { &mi, 1 }, { &s, 1 } });
+  std::cout << "\n\n  now: " << DateTime(one[0]).time();
+  std::cout << "\n  columns: " << y << "-" << mo << "-" << d << " " << h << ":" << mi << ":" << s;
+  std::cout << "\n\n";
+}
+#endif
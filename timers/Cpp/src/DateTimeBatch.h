@@ -0,0 +1,96 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// DateTimeBatch.h - convert columns of time points to calendar    //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+/*
+ * Package Operations:
+ * -------------------
+ * Converts a span of system_clock time points into struct-of-arrays
+ * calendar columns, without a DateTime or a localtime call per value.
+ * - toCalendarUtc(points, columns)     UTC fields
+ * - toCalendarLocal(points, columns)   local time fields
+ *
+ * The field arithmetic is CivilTime's civilFromDays, applied to whole
+ * blocks of values in loops with no calls or table lookups, which
+ * compilers vectorize.  Local time adds a UTC offset looked up in
+ * UtcOffsetCache, which calls localtime only when a value falls outside
+ * the daylight saving window of the previous lookup.
+ *
+ * Column values are natural: year 2026, month 1 - 12, day 1 - 31,
+ * hour 0 - 23, minute 0 - 59, second 0 - 59.  Every column must hold
+ * at least points.size() values.
+ *
+ * Required Files:
+ * ---------------
+ *   DateTimeBatch.h, DateTimeBatch.cpp, DateTime.h, DateTime.cpp,
+ *   CivilTime.h
+ *
+ * Maintenance History:
+ * --------------------
+ * ver 1.0 : 17 Oct 2026
+ * - first release
+*/
+
+#include <cstdint>
+#include <ctime>
+#include <span>
+#include <utility>
+#include "DateTime.h"
+
+namespace Utilities
+{
+  struct CalendarColumns
+  {
+    std::span<int32_t> year;
+    std::span<int32_t> month;
+    std::span<int32_t> day;
+    std::span<int32_t> hour;
+    std::span<int32_t> minute;
+    std::span<int32_t> second;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // UtcOffsetCache - local time offset, cached per daylight saving window
+  // - a lookup outside the cached windows finds the window around the
+  //   new time by probing localtime, then bisecting to the second
+  // - probes are at most 128 hours apart, closer than any two
+  //   successive daylight saving transitions, so none are skipped
+  // - keeps the two most recent windows, so unsorted columns that
+  //   straddle one transition don't reload on every value
+  // - windows reflect the time zone in effect when they were loaded
+
+  class UtcOffsetCache
+  {
+  public:
+    long offsetAt(std::time_t t)
+    {
+      if (windows_[0].contains(t))
+        return windows_[0].offset;
+      if (!windows_[1].contains(t))
+        load(t);
+      std::swap(windows_[0], windows_[1]);
+      return windows_[0].offset;
+    }
+    size_t loads() const { return loads_; }
+  private:
+    struct Window
+    {
+      std::time_t begin = 1;
+      std::time_t end = 0;  // empty until loaded
+      long offset = 0;
+      bool contains(std::time_t t) const { return begin <= t && t < end; }
+    };
+    void load(std::time_t t);
+
+    Window windows_[2];
+    size_t loads_ = 0;
+  };
+
+  void toCalendarUtc(std::span<const DateTime::TimePoint> points, const CalendarColumns& columns);
+  void toCalendarLocal(std::span<const DateTime::TimePoint> points, const CalendarColumns& columns);
+  void toCalendarLocal(
+    std::span<const DateTime::TimePoint> points, const CalendarColumns& columns, UtcOffsetCache& offsets
+  );
+}
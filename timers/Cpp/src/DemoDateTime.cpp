@@ -8,11 +8,20 @@
     ---------------
     DemoDateTime.cpp
     DateTime.h, DateTime.cpp
+    Stopwatch.h, Stopwatch.cpp
+    TimerWheel.h, TimerWheel.cpp
+    Profiler.h, Profiler.cpp
+    Trace.h, Trace.cpp
     StringUtilities.h
 */
 #include <iostream>
 #include "DateTime.h"
+#include "Stopwatch.h"
+#include "TimerWheel.h"
+#include "Profiler.h"
+#include "Trace.h"
 #include <thread>
+#include <atomic>
 
 using namespace Utilities;
 
@@ -27,5 +36,57 @@ int main() {
     std::cout << "\n  Requested sleep for 50 millisecs";
     std::cout << "\n  DateTime reports " << et << " microsecs";
 
-    std::cout << "\n\n  That's all Folks!\n\n";
+    std::cout << "\n\n  -- Demo Stopwatch --";
+
+    Stopwatch sw;
+    sw.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sw.stop();
+    std::cout << "\n  Requested sleep for 50 millisecs";
+    std::cout << "\n  Stopwatch reports " << sw.elapsedNanoseconds() << " nanosecs";
+
+    std::cout << "\n\n  -- Demo TimerService --";
+
+    TimerService timers;
+    std::atomic<bool> fired{ false };
+    Stopwatch tsw;
+    tsw.start();
+    timers.schedule(DateTime::makeDuration(0, 0, 0, 50), [&] {
+        TRACE_SCOPE("timer callback");
+        tsw.stop();
+        fired = true;
+    });
+    while (!fired)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    std::cout << "\n  Scheduled callback in 50 millisecs";
+    std::cout << "\n  callback ran after " << tsw.elapsedMicroseconds() << " microsecs";
+
+    std::cout << "\n\n  -- Demo Profiler --";
+
+    char buffer[DateTime::formatSize];
+    size_t chars = 0;
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        PROFILE_SCOPE("formatNow");
+        chars += DateTime::formatNow(buffer, sizeof(buffer));
+    }
+    std::cout << "\n  formatted " << chars << " chars";
+    Profiler::print();
+
+    std::cout << "\n\n  -- Demo Trace --";
+
+    TraceRecorder::nameThread("main");
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        TRACE_SCOPE("format batch");
+        for (size_t j = 0; j < 10; ++j)
+        {
+            TRACE_SCOPE("formatNow");
+            chars += DateTime::formatNow(buffer, sizeof(buffer));
+        }
+    }
+    if (TraceRecorder::save("DemoDateTime.trace.json"))
+        std::cout << "\n  wrote DemoDateTime.trace.json, open in ui.perfetto.dev";
+
+    std::cout << "\n  That's all Folks!\n\n";
 }
\ No newline at end of file
@@ -0,0 +1,310 @@
+#ifndef OUTBUFFER_H
+#define OUTBUFFER_H
+///////////////////////////////////////////////////////////////////////
+// OutBuffer.h - format output into a buffer, write it in one call   //
+// ver 1.0                                                           //
+// Language:    C++20                                                //
+// Application: Most Projects, CSE687 - Object Oriented Design       //
+// Author:      Jim Fawcett, Syracuse University, CST 4-187          //
+//              jfawcett@twcny.rr.com                                //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Writing a collection to std::cout one item at a time costs a stream
+* call per item, each synchronized with stdio.  OutBuffer formats items
+* into a reusable buffer instead, and writes the buffer in one call when
+* it fills, when flushed, and when destroyed:
+*
+*   OutBuffer out;                        // writes to stdout, fd 1
+*   out.putColl(values, " ", "\n  ");     // prefix, then item + sep each
+*   out << "\n  count = " << values.size();
+*
+* - OutBuffer() and OutBuffer(fd) write to a file descriptor, with
+*   write, or with writev when holding more than one segment.  Before
+*   writing to stdout or stderr, std::cout and stdio are flushed, so
+*   output stays in order.
+* - OutBuffer(stream) writes each flush with one stream.write, so output
+*   follows any redirection of the stream.
+* - Integers and floating point numbers are formatted with std::to_chars.
+*   Floating point values use its shortest round trip form, so may show
+*   more digits than std::cout's default six.  Other types are formatted
+*   with their operator<<, through a reused std::ostringstream.
+* - putRef(text) queues text without copying it, writing it in place with
+*   writev.  Text must live until the next flush.
+*
+* Required Files:
+* ---------------
+*   OutBuffer.h
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 17 Oct 2026
+* - first release
+*
+* Notes:
+* ------
+* - Designed to provide all functionality in header file.
+* - BenchOutput.cpp compares throughput with per item std::cout.
+*/
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace Utilities
+{
+  /* arithmetic types std::to_chars formats, not char types or bool */
+  template <typename T>
+  concept ToCharsNumber = std::floating_point<T> || (std::integral<T>
+    && !std::same_as<T, bool> && !std::same_as<T, char> && !std::same_as<T, signed char>
+    && !std::same_as<T, unsigned char> && !std::same_as<T, wchar_t> && !std::same_as<T, char8_t>
+    && !std::same_as<T, char16_t> && !std::same_as<T, char32_t>);
+
+  /////////////////////////////////////////////////////////////////////
+  // OutBuffer - batches formatted output into few write calls
+
+  class OutBuffer
+  {
+  public:
+    static constexpr size_t defaultCapacity = 64 * 1024;
+
+    explicit OutBuffer(int fd = 1, size_t capacity = defaultCapacity)
+      : fd_(fd), capacity_(capacity) {}
+    explicit OutBuffer(std::ostream& out, size_t capacity = defaultCapacity)
+      : out_(&out), capacity_(capacity) {}
+    ~OutBuffer()
+    {
+      try { flush(); }
+      catch (...) {}
+    }
+    OutBuffer(const OutBuffer&) = delete;
+    OutBuffer& operator=(const OutBuffer&) = delete;
+
+    OutBuffer& put(std::string_view text);
+    OutBuffer& put(const char* text) { return put(std::string_view(text)); }
+    OutBuffer& put(const std::string& text) { return put(std::string_view(text)); }
+    OutBuffer& put(char ch);
+    OutBuffer& put(signed char ch) { return put(static_cast<char>(ch)); }
+    OutBuffer& put(unsigned char ch) { return put(static_cast<char>(ch)); }
+    OutBuffer& put(bool value) { return put(value ? '1' : '0'); }
+    template <ToCharsNumber T>
+    OutBuffer& put(T value);
+    template <typename T> requires (!ToCharsNumber<T>)
+    OutBuffer& put(const T& value);
+
+    template <typename T>
+    OutBuffer& operator<<(const T& value) { return put(value); }
+
+    OutBuffer& putRef(std::string_view text);
+
+    template <typename C>
+    OutBuffer& putColl(C&& coll, std::string_view sep = " ", std::string_view prefix = "");
+
+    bool flush();
+    size_t pending() const { return pending_ + buffer_.size() - sealed_; }
+
+  private:
+    /* bytes of buffer_ from offset, or size bytes at ref */
+    struct Segment
+    {
+      const char* ref;
+      size_t offset;
+      size_t size;
+    };
+    void seal();
+    bool writeFd();
+    void flushIfFull()
+    {
+      if (pending() >= capacity_)
+        flush();
+    }
+
+    int fd_ = -1;
+    std::ostream* out_ = nullptr;
+    size_t capacity_;
+    std::string buffer_;
+    std::vector<Segment> segments_;
+    size_t sealed_ = 0;   // buffer_ bytes already in segments_
+    size_t pending_ = 0;  // bytes in segments_
+    std::unique_ptr<std::ostringstream> scratch_;
+  };
+  //----< append text >------------------------------------------------
+
+  inline OutBuffer& OutBuffer::put(std::string_view text)
+  {
+    buffer_.append(text);
+    flushIfFull();
+    return *this;
+  }
+  //----< append one char >--------------------------------------------
+
+  inline OutBuffer& OutBuffer::put(char ch)
+  {
+    buffer_.push_back(ch);
+    flushIfFull();
+    return *this;
+  }
+  //----< append number formatted with std::to_chars >-----------------
+
+  template <ToCharsNumber T>
+  OutBuffer& OutBuffer::put(T value)
+  {
+    char text[32];
+    auto result = std::to_chars(text, text + sizeof(text), value);
+    buffer_.append(text, result.ptr);
+    flushIfFull();
+    return *this;
+  }
+  //----< append value formatted by its operator<< >-------------------
+
+  template <typename T> requires (!ToCharsNumber<T>)
+  OutBuffer& OutBuffer::put(const T& value)
+  {
+    if (!scratch_)
+      scratch_ = std::make_unique<std::ostringstream>();
+    scratch_->str("");
+    *scratch_ << value;
+    return put(std::string_view(scratch_->view()));
+  }
+  //----< append text without copying, text must outlive next flush >--
+
+  inline OutBuffer& OutBuffer::putRef(std::string_view text)
+  {
+    seal();
+    segments_.push_back(Segment{ text.data(), 0, text.size() });
+    pending_ += text.size();
+    if (pending_ >= capacity_ || segments_.size() >= 512)
+      flush();
+    return *this;
+  }
+  //----< append prefix, then each item followed by sep >--------------
+
+  template <typename C>
+  OutBuffer& OutBuffer::putColl(C&& coll, std::string_view sep, std::string_view prefix)
+  {
+    put(prefix);
+    for (auto&& item : coll)
+    {
+      put(item);
+      put(sep);
+    }
+    return *this;
+  }
+  //----< close current run of buffer_ bytes as a segment >------------
+
+  inline void OutBuffer::seal()
+  {
+    if (buffer_.size() > sealed_)
+    {
+      segments_.push_back(Segment{ nullptr, sealed_, buffer_.size() - sealed_ });
+      pending_ += buffer_.size() - sealed_;
+      sealed_ = buffer_.size();
+    }
+  }
+  //----< write everything pending, false if a write failed >----------
+
+  inline bool OutBuffer::flush()
+  {
+    seal();
+    bool ok = true;
+    if (!segments_.empty())
+    {
+      if (out_)
+      {
+        for (auto& seg : segments_)
+          out_->write(seg.ref ? seg.ref : buffer_.data() + seg.offset, static_cast<std::streamsize>(seg.size));
+        out_->flush();
+        ok = static_cast<bool>(*out_);
+      }
+      else
+      {
+        if (fd_ == 1)
+        {
+          std::cout.flush();
+          std::fflush(stdout);
+        }
+        else if (fd_ == 2)
+        {
+          std::cerr.flush();
+          std::fflush(stderr);
+        }
+        ok = writeFd();
+      }
+    }
+    buffer_.clear();
+    segments_.clear();
+    sealed_ = 0;
+    pending_ = 0;
+    return ok;
+  }
+  //----< write segments to fd_, resuming after partial writes >-------
+
+  inline bool OutBuffer::writeFd()
+  {
+#ifdef _WIN32
+    for (auto& seg : segments_)
+    {
+      const char* data = seg.ref ? seg.ref : buffer_.data() + seg.offset;
+      size_t left = seg.size;
+      while (left > 0)
+      {
+        int chunk = static_cast<int>(std::min<size_t>(left, 1 << 30));
+        int written = _write(fd_, data, chunk);
+        if (written <= 0)
+          return false;
+        data += written;
+        left -= static_cast<size_t>(written);
+      }
+    }
+    return true;
+#else
+    std::vector<iovec> iov(segments_.size());
+    for (size_t i = 0; i < segments_.size(); ++i)
+    {
+      const char* data = segments_[i].ref ? segments_[i].ref : buffer_.data() + segments_[i].offset;
+      iov[i].iov_base = const_cast<char*>(data);
+      iov[i].iov_len = segments_[i].size;
+    }
+    size_t first = 0;
+    while (first < iov.size())
+    {
+      int count = static_cast<int>(std::min<size_t>(iov.size() - first, IOV_MAX));
+      ssize_t written = count == 1
+        ? ::write(fd_, iov[first].iov_base, iov[first].iov_len)
+        : ::writev(fd_, &iov[first], count);
+      if (written < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      size_t done = static_cast<size_t>(written);
+      while (first < iov.size() && done >= iov[first].iov_len)
+        done -= iov[first++].iov_len;
+      if (done > 0)
+      {
+        iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + done;
+        iov[first].iov_len -= done;
+      }
+    }
+    return true;
+#endif
+  }
+}
+#endif
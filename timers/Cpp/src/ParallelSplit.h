@@ -0,0 +1,152 @@
+#ifndef PARALLELSPLIT_H
+#define PARALLELSPLIT_H
+///////////////////////////////////////////////////////////////////////
+// ParallelSplit.h - split very large strings on several threads     //
+// ver 1.0                                                           //
+// Language:    C++20                                                //
+// Application: Most Projects, CSE687 - Object Oriented Design       //
+// Author:      Jim Fawcett, Syracuse University, CST 4-187          //
+//              jfawcett@twcny.rr.com                                //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides functions:
+* - splitPartitions(str, 'delim', n)        partition boundaries, each one
+*                                           just after a delimiter
+* - split_view_parallel(str, 'delim', n)    vector of trimmed slices
+* - split_parallel(str, 'delim', n)         vector of trimmed strings
+*
+* The input is cut into n nearly equal partitions, each boundary moved
+* forward to just past the next delimiter.  Every partition but the
+* last ends with a delimiter, so splitting partitions independently and
+* concatenating the results, in partition order, gives exactly the
+* tokens of split(str, 'delim').  n = 0 uses one thread per core.
+* Inputs smaller than minPartition per thread use fewer threads.
+*
+* Required Files:
+* ---------------
+*   ParallelSplit.h, StringUtilities.h, StringScan.h
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 17 Oct 2026
+* - first release
+*
+* Notes:
+* ------
+* - Designed to provide all functionality in header file.
+* - BenchParallelSplit.cpp measures scaling over 1 to N threads.
+*/
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include "StringUtilities.h"
+
+namespace Utilities
+{
+  constexpr size_t minPartition = 64 * 1024;
+
+  //----< number of threads to use for n requested, 0 means all cores >---
+
+  inline size_t splitThreads(size_t size, size_t n)
+  {
+    if (n == 0)
+      n = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t useful = std::max<size_t>(1, size / minPartition);
+    return std::min(n, useful);
+  }
+  //----< start of each partition, plus size of src as last entry >------
+
+  template <typename T>
+  std::vector<size_t> splitPartitions(std::basic_string_view<T> src, T splitOn, size_t n)
+  {
+    std::vector<size_t> bounds{ 0 };
+    for (size_t i = 1; i < n; ++i)
+    {
+      size_t pos = std::max(src.size() / n * i, bounds.back());
+      size_t delim = src.find(splitOn, pos);
+      if (delim == std::basic_string_view<T>::npos)
+        break;
+      if (delim + 1 > bounds.back())
+        bounds.push_back(delim + 1);
+    }
+    if (bounds.back() != src.size())
+      bounds.push_back(src.size());
+    return bounds;
+  }
+  //----< split src into trimmed slices using n threads >----------------
+
+  template <typename T>
+  std::vector<std::basic_string_view<T>> split_view_parallel(
+    std::basic_string_view<T> src, T splitOn = ',', size_t n = 0
+  )
+  {
+    using View = std::basic_string_view<T>;
+    std::vector<size_t> bounds = splitPartitions(src, splitOn, splitThreads(src.size(), n));
+    size_t parts = bounds.size() - 1;
+    std::vector<std::vector<View>> partials(parts);
+
+    auto work = [&](size_t i) {
+      View part = src.substr(bounds[i], bounds[i + 1] - bounds[i]);
+      for (View token : split_view(part, splitOn))
+        partials[i].push_back(token);
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < parts; ++i)
+      threads.emplace_back(work, i);
+    if (parts > 0)
+      work(0);
+    for (auto& thread : threads)
+      thread.join();
+
+    if (parts == 1)
+      return std::move(partials[0]);
+    size_t total = 0;
+    for (auto& partial : partials)
+      total += partial.size();
+    std::vector<View> tokens;
+    tokens.reserve(total);
+    for (auto& partial : partials)
+      tokens.insert(tokens.end(), partial.begin(), partial.end());
+    return tokens;
+  }
+
+  template <typename T>
+  std::vector<std::basic_string_view<T>> split_view_parallel(
+    const std::basic_string<T>& src, T splitOn = ',', size_t n = 0
+  )
+  {
+    return split_view_parallel(std::basic_string_view<T>(src), splitOn, n);
+  }
+  //----< split src into trimmed strings using n threads >---------------
+  /*
+  *  - strings are built in place, in parallel, in the result vector
+  */
+  template <typename T>
+  std::vector<std::basic_string<T>> split_parallel(
+    const std::basic_string<T>& src, T splitOn = ',', size_t n = 0
+  )
+  {
+    std::vector<std::basic_string_view<T>> views = split_view_parallel(src, splitOn, n);
+    std::vector<std::basic_string<T>> tokens(views.size());
+    size_t threadCount = std::max<size_t>(1, std::min(splitThreads(src.size(), n), views.size()));
+    size_t block = (views.size() + threadCount - 1) / threadCount;
+
+    auto work = [&](size_t i) {
+      size_t last = std::min(views.size(), (i + 1) * block);
+      for (size_t j = i * block; j < last; ++j)
+        tokens[j].assign(views[j]);
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; ++i)
+      threads.emplace_back(work, i);
+    work(0);
+    for (auto& thread : threads)
+      thread.join();
+    return tokens;
+  }
+}
+#endif
@@ -0,0 +1,244 @@
+/////////////////////////////////////////////////////////////////////
+// Profiler.cpp - scoped latency probes with per-thread histograms //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+
+#include "Profiler.h"
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+using namespace Utilities;
+
+//----< histogram bucket holding nanos >-----------------------------
+/*
+ * Values below 64 have a bucket each.  Above, each power of two is
+ * split into 64 buckets by the six bits below the leading one.
+ */
+size_t LatencyHistogram::bucketOf(uint64_t nanos)
+{
+  nanos = std::min(nanos, (uint64_t(1) << maxBits) - 1);
+  if (nanos < subBuckets)
+    return static_cast<size_t>(nanos);
+  size_t msb = static_cast<size_t>(std::bit_width(nanos)) - 1;
+  size_t shift = msb - subBits;
+  size_t sub = static_cast<size_t>(nanos >> shift) - subBuckets;
+  return (shift + 1) * subBuckets + sub;
+}
+//----< largest value counted in bucket >----------------------------
+
+uint64_t LatencyHistogram::highestIn(size_t bucket)
+{
+  if (bucket < subBuckets)
+    return bucket;
+  size_t shift = bucket / subBuckets - 1;
+  uint64_t lowest = static_cast<uint64_t>(subBuckets + bucket % subBuckets) << shift;
+  return lowest + (uint64_t(1) << shift) - 1;
+}
+//----< add this histogram's counts to the running totals >----------
+
+void LatencyHistogram::mergeInto(
+  std::vector<uint64_t>& counts, uint64_t& count, uint64_t& sum, uint64_t& max
+) const
+{
+  counts.resize(buckets);
+  for (size_t i = 0; i < buckets; ++i)
+    counts[i] += counts_[i].load(std::memory_order_relaxed);
+  count += count_.load(std::memory_order_relaxed);
+  sum += sum_.load(std::memory_order_relaxed);
+  max = std::max(max, max_.load(std::memory_order_relaxed));
+}
+
+//----< per-thread histograms and the registry of probes >-----------
+/*
+ * A thread creates its ThreadHistograms on first record and adds it
+ * to the registry, which keeps it after the thread ends so its counts
+ * still show in reports.  Only the owning thread creates histograms,
+ * publishing each with a release store for report() to acquire.
+ */
+namespace
+{
+  struct ThreadHistograms
+  {
+    std::atomic<LatencyHistogram*> probes[Profiler::maxProbes] = {};
+    ~ThreadHistograms()
+    {
+      for (auto& probe : probes)
+        delete probe.load();
+    }
+  };
+
+  struct Registry
+  {
+    std::mutex mtx;
+    std::vector<std::string> names;
+    std::vector<std::shared_ptr<ThreadHistograms>> threads;
+  };
+
+  Registry& registry()
+  {
+    static Registry instance;
+    return instance;
+  }
+
+  ThreadHistograms& threadHistograms()
+  {
+    thread_local std::shared_ptr<ThreadHistograms> local = [] {
+      auto histograms = std::make_shared<ThreadHistograms>();
+      Registry& reg = registry();
+      std::lock_guard<std::mutex> lock(reg.mtx);
+      reg.threads.push_back(histograms);
+      return histograms;
+    }();
+    return *local;
+  }
+
+  /*-- smallest value with at least fraction q of counts at or below --*/
+  uint64_t percentile(const std::vector<uint64_t>& counts, uint64_t total, double q, uint64_t max)
+  {
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * static_cast<double>(total) + 0.999999));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+      seen += counts[i];
+      if (seen >= rank)
+        return std::min(LatencyHistogram::highestIn(i), max);
+    }
+    return max;
+  }
+}
+//----< id of the probe with this name, registering it if new >------
+
+uint32_t Profiler::probeId(std::string_view name)
+{
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mtx);
+  auto iter = std::find(reg.names.begin(), reg.names.end(), name);
+  if (iter != reg.names.end())
+    return static_cast<uint32_t>(iter - reg.names.begin());
+  if (reg.names.size() == maxProbes)
+    throw std::length_error("Profiler: more than maxProbes probes");
+  reg.names.emplace_back(name);
+  return static_cast<uint32_t>(reg.names.size() - 1);
+}
+//----< record a latency in this thread's histogram for probe >------
+
+void Profiler::record(uint32_t probe, uint64_t nanos)
+{
+  std::atomic<LatencyHistogram*>& slot = threadHistograms().probes[probe];
+  LatencyHistogram* histogram = slot.load(std::memory_order_relaxed);
+  if (histogram == nullptr)
+  {
+    histogram = new LatencyHistogram;
+    slot.store(histogram, std::memory_order_release);
+  }
+  histogram->record(nanos);
+}
+//----< merge every thread's histograms, probes in registration order >
+
+std::vector<ProbeStats> Profiler::report()
+{
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mtx);
+  std::vector<ProbeStats> stats;
+  std::vector<uint64_t> counts;
+  for (size_t probe = 0; probe < reg.names.size(); ++probe)
+  {
+    counts.assign(LatencyHistogram::buckets, 0);
+    uint64_t count = 0, sum = 0, max = 0;
+    for (auto& thread : reg.threads)
+    {
+      LatencyHistogram* histogram = thread->probes[probe].load(std::memory_order_acquire);
+      if (histogram != nullptr)
+        histogram->mergeInto(counts, count, sum, max);
+    }
+    ProbeStats ps{ reg.names[probe], count, 0.0, 0, 0, 0, max };
+    if (count > 0)
+    {
+      ps.mean = static_cast<double>(sum) / static_cast<double>(count);
+      ps.p50 = percentile(counts, count, 0.50, max);
+      ps.p99 = percentile(counts, count, 0.99, max);
+      ps.p999 = percentile(counts, count, 0.999, max);
+    }
+    stats.push_back(std::move(ps));
+  }
+  return stats;
+}
+//----< write report as a table, in nanoseconds >--------------------
+
+void Profiler::print(std::ostream& out)
+{
+  std::vector<ProbeStats> stats = report();
+  size_t width = 8;
+  for (auto& ps : stats)
+    width = std::max(width, ps.name.size() + 2);
+
+  out << "\n  " << std::left << std::setw(static_cast<int>(width)) << "probe" << std::right
+      << std::setw(10) << "count" << std::setw(12) << "mean ns" << std::setw(12) << "p50"
+      << std::setw(12) << "p99" << std::setw(12) << "p99.9" << std::setw(12) << "max";
+  for (auto& ps : stats)
+  {
+    out << "\n  " << std::left << std::setw(static_cast<int>(width)) << ps.name << std::right
+        << std::setw(10) << ps.count << std::setw(12) << std::fixed << std::setprecision(1) << ps.mean
+        << std::setw(12) << ps.p50 << std::setw(12) << ps.p99 << std::setw(12) << ps.p999
+        << std::setw(12) << ps.max;
+  }
+  out << "\n";
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_PROFILER
+
+#include <thread>
+#include "StringUtilities.h"
+
+/*-- work whose latency grows with n --*/
+uint64_t work(size_t n)
+{
+  PROFILE_SCOPE("work");
+  uint64_t sum = 0;
+  for (size_t i = 0; i < n; ++i)
+    sum += i * i;
+  return sum;
+}
+
+int main()
+{
+  Utilities::Title("Testing Profiler");
+
+  size_t errors = 0;
+  for (uint64_t v : { 0ull, 63ull, 64ull, 127ull, 128ull, 1000ull, 123456789ull, 1ull << 39 })
+  {
+    uint64_t high = LatencyHistogram::highestIn(LatencyHistogram::bucketOf(v));
+    if (high < v || static_cast<double>(high - v) > 0.016 * static_cast<double>(v))
+      ++errors;
+  }
+  std::cout << "\n  bucket bound errors: " << errors;
+
+  std::vector<std::thread> threads;
+  std::atomic<uint64_t> sink = 0;
+  for (size_t t = 0; t < 4; ++t)
+    threads.emplace_back([&sink, t] {
+      uint64_t sum = 0;
+      for (size_t i = 0; i < 100000; ++i)
+        sum += work(i % 100 == 0 ? 20000 : 100 + t);
+      sink += sum;
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  Probe empty("empty scope");
+  for (size_t i = 0; i < 1000000; ++i)
+  {
+    ScopedTimer timer(empty);
+  }
+  std::cout << "\n  4 threads, 1% of calls 200 times slower";
+  Profiler::print();
+  std::cout << "\n";
+}
+#endif
@@ -0,0 +1,151 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// Profiler.h - scoped latency probes with per-thread histograms   //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+/*
+ * Package Operations:
+ * -------------------
+ * Records how long named sections of code take, every time they run,
+ * and reports percentiles of the latencies.
+ *
+ *   void handle() {
+ *     PROFILE_SCOPE("handle");   // times the rest of this block
+ *     ...
+ *   }
+ *   Profiler::print();           // count, mean, p50, p99, p99.9, max
+ *
+ * - Probe names a section.  Probes with the same name share one id.
+ * - ScopedTimer reads the time stamp counter when constructed and
+ *   records the elapsed nanoseconds in its Probe when destroyed.
+ * - Each thread records into its own LatencyHistograms, one per
+ *   probe, with no locks or atomic read-modify-writes.  report()
+ *   merges all threads' histograms, including threads that have
+ *   ended, while recording goes on.
+ * - LatencyHistogram is HDR style: 64 linear sub-buckets for each
+ *   power of two, so reported values are within 1.6% of the recorded
+ *   ones, from 1 nanosecond to 18 minutes, in 18 KB.
+ *
+ * Define PROFILER_DISABLED to compile PROFILE_SCOPE to nothing.
+ *
+ * Required Files:
+ * ---------------
+ *   Profiler.h, Profiler.cpp, Stopwatch.h, Stopwatch.cpp
+ *
+ * Maintenance History:
+ * --------------------
+ * ver 1.0 : 17 Oct 2026
+ * - first release
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Stopwatch.h"
+
+namespace Utilities
+{
+  /////////////////////////////////////////////////////////////////////
+  // LatencyHistogram - log-linear counts of nanosecond latencies
+  // - written by one thread, read by any, so counts are atomics
+  //   updated with relaxed load and store, not fetch_add
+
+  class LatencyHistogram
+  {
+  public:
+    static constexpr size_t subBits = 6;
+    static constexpr size_t subBuckets = size_t(1) << subBits;
+    static constexpr size_t maxBits = 40;  // larger values are clamped
+    static constexpr size_t buckets = (maxBits - subBits + 1) * subBuckets;
+
+    void record(uint64_t nanos)
+    {
+      bump(counts_[bucketOf(nanos)], 1);
+      bump(count_, 1);
+      bump(sum_, nanos);
+      if (nanos > max_.load(std::memory_order_relaxed))
+        max_.store(nanos, std::memory_order_relaxed);
+    }
+    void mergeInto(std::vector<uint64_t>& counts, uint64_t& count, uint64_t& sum, uint64_t& max) const;
+
+    static size_t bucketOf(uint64_t nanos);
+    static uint64_t highestIn(size_t bucket);
+  private:
+    static void bump(std::atomic<uint64_t>& value, uint64_t by)
+    {
+      value.store(value.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+    std::atomic<uint64_t> counts_[buckets] = {};
+    std::atomic<uint64_t> count_ = 0;
+    std::atomic<uint64_t> sum_ = 0;
+    std::atomic<uint64_t> max_ = 0;
+  };
+
+  struct ProbeStats
+  {
+    std::string name;
+    uint64_t count;
+    double mean;
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t p999;
+    uint64_t max;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // Profiler - probe registry and merged reports
+
+  class Profiler
+  {
+  public:
+    static constexpr size_t maxProbes = 256;
+
+    static uint32_t probeId(std::string_view name);
+    static void record(uint32_t probe, uint64_t nanos);
+    static std::vector<ProbeStats> report();
+    static void print(std::ostream& out = std::cout);
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // Probe - a named, registered section of code
+
+  class Probe
+  {
+  public:
+    explicit Probe(std::string_view name) : id_(Profiler::probeId(name)) {}
+    uint32_t id() const { return id_; }
+    void record(uint64_t nanos) const { Profiler::record(id_, nanos); }
+  private:
+    uint32_t id_;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // ScopedTimer - records its lifetime in a Probe
+
+  class ScopedTimer
+  {
+  public:
+    explicit ScopedTimer(const Probe& probe) : probe_(probe), start_(TscTicks::start()) {}
+    ~ScopedTimer() { probe_.record(TscTicks::toNanoseconds(TscTicks::stop() - start_)); }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+  private:
+    const Probe& probe_;
+    uint64_t start_;
+  };
+}
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_NAME_(a, b) PROFILE_CONCAT_(a, b)
+
+#ifdef PROFILER_DISABLED
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_SCOPE(name) \
+  static const Utilities::Probe PROFILE_NAME_(profileProbe_, __LINE__)(name); \
+  Utilities::ScopedTimer PROFILE_NAME_(profileTimer_, __LINE__)(PROFILE_NAME_(profileProbe_, __LINE__))
+#endif
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////
+// SplitStream.cpp - split streams and mapped files in bounded memory//
+// ver 1.0                                                           //
+// Language:    C++20                                                //
+// Application: Most Projects, CSE687 - Object Oriented Design       //
+// Author:      Jim Fawcett, Syracuse University, CST 4-187          //
+//              jfawcett@twcny.rr.com                                //
+///////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include "SplitStream.h"
+
+#ifdef TEST_SPLITSTREAM
+
+using namespace Utilities;
+
+int main()
+{
+  Title("Testing SplitStream Package");
+  putline();
+
+  std::string test = "a, \n, bc, de, efg, i, j k lm nopq rst,a much longer token spanning chunks, ";
+  std::vector<std::string> expected = split(test);
+
+  title("test StreamSplitter with chunk sizes that split tokens");
+  for (size_t chunk : { 1, 2, 3, 7, 64 })
+  {
+    std::istringstream in(test);
+    StreamSplitter splitter(in, ',', chunk);
+    std::vector<std::string> tokens;
+    std::string_view token;
+    while (splitter.next(token))
+      tokens.emplace_back(token);
+    std::cout << "\n  chunk size " << chunk << ": " << tokens.size() << " tokens, "
+              << (tokens == expected ? "same as split" : "DIFFERENT from split")
+              << ", buffer grew to " << splitter.capacity();
+  }
+  putline();
+
+  title("test split_view over MappedFile");
+  const char* path = "SplitStreamTest.txt";
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << test;
+  }
+  {
+    MappedFile file(path);
+    std::vector<std::string> tokens;
+    for (std::string_view token : split_view(file.view(), ','))
+      tokens.emplace_back(token);
+    std::cout << "\n  mapped " << file.size() << " bytes: " << tokens.size() << " tokens, "
+              << (tokens == expected ? "same as split" : "DIFFERENT from split");
+    showSplits(tokens);
+  }
+  std::remove(path);
+
+  try
+  {
+    MappedFile missing("no such file");
+  }
+  catch (std::exception& ex)
+  {
+    std::cout << "\n  -- " << ex.what() << " --";
+  }
+
+  putline(2);
+  return 0;
+}
+#endif
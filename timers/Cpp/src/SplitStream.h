@@ -0,0 +1,239 @@
+#ifndef SPLITSTREAM_H
+#define SPLITSTREAM_H
+///////////////////////////////////////////////////////////////////////
+// SplitStream.h - split streams and mapped files in bounded memory  //
+// ver 1.0                                                           //
+// Language:    C++20                                                //
+// Application: Most Projects, CSE687 - Object Oriented Design       //
+// Author:      Jim Fawcett, Syracuse University, CST 4-187          //
+//              jfawcett@twcny.rr.com                                //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides classes:
+* - StreamSplitter   reads an std::istream in fixed size chunks and
+*                    yields trimmed tokens one at a time
+* - MappedFile       maps a file read-only, exposing it as a string_view
+*                    that split_view can walk without reading it in
+*
+* Both produce the same tokens as Utilities::split on the whole text.
+* StreamSplitter holds one chunk plus any token straddling a chunk
+* boundary, so memory is bounded by chunk size and the longest token.
+*
+* Example:
+*   std::ifstream in("big.csv");
+*   StreamSplitter splitter(in, ',');
+*   std::string_view token;
+*   while (splitter.next(token))
+*     use(token);   // token valid until the next call to next
+*
+*   MappedFile file("big.csv");
+*   for (std::string_view token : split_view(file.view(), ','))
+*     use(token);   // token valid while file is mapped
+*
+* Required Files:
+* ---------------
+*   SplitStream.h, StringUtilities.h, StringScan.h
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 17 Oct 2026
+* - first release
+*
+* Notes:
+* ------
+* - Designed to provide all functionality in header file.
+* - Implementation file only needed for test and demo.
+*/
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include "StringUtilities.h"
+#include "StringScan.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Utilities
+{
+  /////////////////////////////////////////////////////////////////////
+  // StreamSplitter - incremental, chunked split over an std::istream
+
+  class StreamSplitter
+  {
+  public:
+    StreamSplitter(std::istream& in, char splitOn = ',', size_t chunkSize = 64 * 1024)
+      : in_(in), splitOn_(splitOn), buffer_(chunkSize > 0 ? chunkSize : 1) {}
+
+    StreamSplitter(const StreamSplitter&) = delete;
+    StreamSplitter& operator=(const StreamSplitter&) = delete;
+
+    //----< get next trimmed token, returns false when input is done >---
+    /*
+    *  - token refers to internal buffer, valid until the next call
+    */
+    bool next(std::string_view& token)
+    {
+      while (true)
+      {
+        size_t end = scanner_.next(scanned_);
+        if (end < filled_)
+        {
+          token = trim_view(std::string_view(buffer_.data() + pos_, end - pos_));
+          pos_ = end + 1;
+          scanned_ = pos_;
+          return true;
+        }
+        scanned_ = filled_;
+        if (eof_)
+        {
+          if (pos_ >= filled_)  // nothing after last delimiter
+            return false;
+          token = trim_view(std::string_view(buffer_.data() + pos_, filled_ - pos_));
+          pos_ = filled_;
+          return true;
+        }
+        refill();
+      }
+    }
+    //----< largest buffer used so far, chunk size unless a token was larger >---
+
+    size_t capacity() const { return buffer_.size(); }
+
+  private:
+    //----< keep partial token, then read next chunk after it >----------
+
+    void refill()
+    {
+      size_t carry = filled_ - pos_;
+      if (carry > 0 && pos_ > 0)
+        std::memmove(buffer_.data(), buffer_.data() + pos_, carry);
+      if (carry == buffer_.size())  // token longer than buffer
+        buffer_.resize(2 * buffer_.size());
+      pos_ = 0;
+      scanned_ = carry;
+      filled_ = carry;
+      in_.read(buffer_.data() + filled_, static_cast<std::streamsize>(buffer_.size() - filled_));
+      filled_ += static_cast<size_t>(in_.gcount());
+      if (!in_)
+        eof_ = true;
+      scanner_ = DelimScanner(buffer_.data(), filled_, splitOn_);
+    }
+
+    std::istream& in_;
+    char splitOn_;
+    std::vector<char> buffer_;
+    DelimScanner scanner_;
+    size_t pos_ = 0;      // start of current token
+    size_t scanned_ = 0;  // no delimiters in [pos_, scanned_)
+    size_t filled_ = 0;   // end of valid data
+    bool eof_ = false;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // MappedFile - read-only memory map of a whole file
+  // - pages are loaded by the OS as they are touched, and may be
+  //   discarded under memory pressure, so files larger than RAM work
+  // - throws std::runtime_error if the file can't be opened or mapped
+
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(const std::string& path)
+    {
+#ifdef _WIN32
+      file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+      if (file_ == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("can't open " + path);
+      LARGE_INTEGER size;
+      GetFileSizeEx(file_, &size);
+      size_ = static_cast<size_t>(size.QuadPart);
+      if (size_ > 0)
+      {
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ != nullptr)
+          data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_ == nullptr)
+        {
+          close();
+          throw std::runtime_error("can't map " + path);
+        }
+      }
+#else
+      fd_ = ::open(path.c_str(), O_RDONLY);
+      if (fd_ < 0)
+        throw std::runtime_error("can't open " + path);
+      struct stat info;
+      if (::fstat(fd_, &info) != 0)
+      {
+        close();
+        throw std::runtime_error("can't stat " + path);
+      }
+      size_ = static_cast<size_t>(info.st_size);
+      if (size_ > 0)
+      {
+        void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (addr == MAP_FAILED)
+        {
+          close();
+          throw std::runtime_error("can't map " + path);
+        }
+        data_ = static_cast<const char*>(addr);
+        ::madvise(addr, size_, MADV_SEQUENTIAL);
+      }
+#endif
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    std::string_view view() const { return std::string_view(data_ ? data_ : "", size_); }
+    size_t size() const { return size_; }
+
+  private:
+    void close()
+    {
+#ifdef _WIN32
+      if (data_ != nullptr)
+        UnmapViewOfFile(data_);
+      if (mapping_ != nullptr)
+        CloseHandle(mapping_);
+      if (file_ != INVALID_HANDLE_VALUE)
+        CloseHandle(file_);
+      mapping_ = nullptr;
+      file_ = INVALID_HANDLE_VALUE;
+#else
+      if (data_ != nullptr)
+        ::munmap(const_cast<char*>(data_), size_);
+      if (fd_ >= 0)
+        ::close(fd_);
+      fd_ = -1;
+#endif
+      data_ = nullptr;
+    }
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+  };
+}
+#endif
@@ -0,0 +1,299 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// Stopwatch.h - lightweight interval timer for hot paths          //
+// ver 1.1                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+/*
+ * Package Operations:
+ * -------------------
+ * Stopwatch measures elapsed time in nanoseconds.  Unlike DateTime it
+ * carries no calendar time, holds only two tick counts and a flag, never
+ * allocates or locks, and inlines to a pair of clock reads, so it can
+ * bracket sub-microsecond sections of code.
+ *
+ * Two tick sources are provided:
+ * - SteadyTicks  std::chrono::steady_clock, always available
+ * - TscTicks     the CPU time stamp counter, read with rdtsc/rdtscp and
+ *                converted to nanoseconds with a rate calibrated against
+ *                steady_clock.  Falls back to steady_clock where there
+ *                is no invariant TSC.
+ *
+ *   Stopwatch sw;            // BasicStopwatch<SteadyTicks>
+ *   TscStopwatch tsw;        // BasicStopwatch<TscTicks>
+ *   TscTicks::calibrate();   // optional, at startup, else on first use
+ *   sw.start(); work(); sw.stop();
+ *   uint64_t ns = sw.elapsedNanoseconds();
+ *
+ * Every interval includes the cost of one clock read, and no interval
+ * is finer than the clock's resolution.  clockCalibration<Ticks>()
+ * measures both once, on first use:
+ * - overheadNs     median time between back to back start() and stop()
+ * - resolutionNs   smallest nonzero step between successive reads
+ * elapsedNetNanoseconds() subtracts the overhead.
+ *
+ * For intervals near the overhead or resolution, time many samples:
+ *   IntervalStats stats = sampleIntervals([&] { work(); }, 1001);
+ *   auto ci = stats.confidence(0.95);   // bounds on the mean, nanosecs
+ *
+ * Required Files:
+ * ---------------
+ *   Stopwatch.h, Stopwatch.cpp
+ *
+ * Maintenance History:
+ * --------------------
+ * ver 1.1 : 17 Oct 2026
+ * - added clock calibration, elapsedNetNanoseconds, IntervalStats
+ *   with confidence intervals, and sampleIntervals
+ * ver 1.0 : 17 Oct 2026
+ * - first release
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define STOPWATCH_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace Utilities
+{
+  /////////////////////////////////////////////////////////////////////
+  // SteadyTicks - tick source reading steady_clock, ticks are nanoseconds
+
+  struct SteadyTicks
+  {
+    static uint64_t start() { return now(); }
+    static uint64_t stop() { return now(); }
+    static uint64_t toNanoseconds(uint64_t ticks) { return ticks; }
+    static double nanosecondsPerTick() { return 1.0; }
+    static uint64_t now()
+    {
+      auto since = std::chrono::steady_clock::now().time_since_epoch();
+      return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(since).count()
+      );
+    }
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // TscTicks - tick source reading the CPU time stamp counter
+  // - start() fences so earlier instructions finish before the read,
+  //   stop() uses rdtscp so the timed instructions finish before it
+  // - toNanoseconds uses the rate found by calibrate()
+
+  struct TscTicks
+  {
+    static bool available();
+    static double calibrate();
+    static double nanosecondsPerTick();
+
+    static uint64_t start()
+    {
+#ifdef STOPWATCH_X86
+      if (useTsc())
+      {
+        _mm_lfence();
+        uint64_t ticks = __rdtsc();
+        _mm_lfence();
+        return ticks;
+      }
+#endif
+      return SteadyTicks::now();
+    }
+    static uint64_t stop()
+    {
+#ifdef STOPWATCH_X86
+      if (useTsc())
+      {
+        unsigned int aux;
+        uint64_t ticks = __rdtscp(&aux);
+        _mm_lfence();
+        return ticks;
+      }
+#endif
+      return SteadyTicks::now();
+    }
+    static uint64_t toNanoseconds(uint64_t ticks)
+    {
+      if (!useTsc())
+        return ticks;
+      return static_cast<uint64_t>(static_cast<double>(ticks) * nanosecondsPerTick() + 0.5);
+    }
+  private:
+    static bool useTsc()
+    {
+      static const bool use = available();
+      return use;
+    }
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // ClockCalibration - cost and granularity of a tick source
+
+  struct ClockCalibration
+  {
+    double overheadNs;    // cost of a start() and stop() pair
+    double resolutionNs;  // smallest step the clock reports
+  };
+
+  //----< measure overhead and resolution of Ticks, a few millisecs >--
+  /*
+   * The overhead is the median of many empty intervals, so preemptions
+   * during calibration don't inflate it.
+   */
+  template <typename Ticks>
+  ClockCalibration calibrateClock(size_t samples = 10001)
+  {
+    std::vector<uint64_t> empty(samples > 0 ? samples : 1);
+    for (uint64_t& ticks : empty)
+    {
+      uint64_t t0 = Ticks::start();
+      uint64_t t1 = Ticks::stop();
+      ticks = t1 - t0;
+    }
+    std::nth_element(empty.begin(), empty.begin() + empty.size() / 2, empty.end());
+    uint64_t overhead = empty[empty.size() / 2];
+
+    uint64_t step = ~uint64_t(0);
+    for (size_t trial = 0; trial < 1000; ++trial)
+    {
+      uint64_t t0 = Ticks::start();
+      uint64_t t1 = t0;
+      for (size_t spin = 0; spin < 1000000 && t1 == t0; ++spin)
+        t1 = Ticks::start();
+      if (t1 != t0)
+        step = std::min(step, t1 - t0);
+    }
+    double perTick = Ticks::nanosecondsPerTick();
+    return ClockCalibration{
+      static_cast<double>(overhead) * perTick,
+      step == ~uint64_t(0) ? 0.0 : static_cast<double>(step) * perTick
+    };
+  }
+  //----< calibration of Ticks, measured once per process >------------
+
+  template <typename Ticks>
+  const ClockCalibration& clockCalibration()
+  {
+    static const ClockCalibration calibration = calibrateClock<Ticks>();
+    return calibration;
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // BasicStopwatch<Ticks> - start/stop interval timer
+
+  template <typename Ticks>
+  class BasicStopwatch
+  {
+  public:
+    void start()
+    {
+      running_ = true;
+      start_ = Ticks::start();
+    }
+    void stop()
+    {
+      end_ = Ticks::stop();
+      running_ = false;
+    }
+    void reset()
+    {
+      start_ = end_ = 0;
+      running_ = false;
+    }
+    bool running() const { return running_; }
+
+    //----< raw tick count, reading the clock if still running >-------
+
+    uint64_t elapsedTicks() const
+    {
+      uint64_t end = running_ ? Ticks::stop() : end_;
+      return end - start_;
+    }
+    uint64_t elapsedNanoseconds() const
+    {
+      return Ticks::toNanoseconds(elapsedTicks());
+    }
+    double elapsedMicroseconds() const
+    {
+      return static_cast<double>(elapsedNanoseconds()) / 1000.0;
+    }
+    double elapsedMilliseconds() const
+    {
+      return static_cast<double>(elapsedNanoseconds()) / 1.0e6;
+    }
+    //----< elapsed time less the cost of reading the clock >----------
+
+    double elapsedNetNanoseconds() const
+    {
+      double net = static_cast<double>(elapsedNanoseconds()) - clockCalibration<Ticks>().overheadNs;
+      return net > 0.0 ? net : 0.0;
+    }
+  private:
+    uint64_t start_ = 0;
+    uint64_t end_ = 0;
+    bool running_ = false;
+  };
+
+  using Stopwatch = BasicStopwatch<SteadyTicks>;
+  using TscStopwatch = BasicStopwatch<TscTicks>;
+
+  /////////////////////////////////////////////////////////////////////
+  // IntervalStats - summary of repeated interval samples
+  // - confidence(level) bounds the mean using Student's t, so a few
+  //   samples give honestly wide intervals
+
+  class IntervalStats
+  {
+  public:
+    struct Interval
+    {
+      double low;
+      double high;
+    };
+    void add(double nanos) { samples_.push_back(nanos); }
+    void clear() { samples_.clear(); }
+    size_t count() const { return samples_.size(); }
+    const std::vector<double>& samples() const { return samples_; }
+
+    double mean() const;
+    double stddev() const;
+    double median() const;
+    double min() const;
+    double max() const;
+    Interval confidence(double level = 0.95) const;
+
+    static double studentT(double level, size_t degrees);
+  private:
+    std::vector<double> samples_;
+  };
+
+  //----< time body samples times, each less clock overhead >----------
+  /*
+   * Net samples are not clamped at zero, so their mean stays unbiased
+   * for bodies cheaper than the clock's resolution.
+   */
+  template <typename Ticks = SteadyTicks, typename Body>
+  IntervalStats sampleIntervals(Body&& body, size_t samples)
+  {
+    const double overhead = clockCalibration<Ticks>().overheadNs;
+    IntervalStats stats;
+    for (size_t i = 0; i < samples; ++i)
+    {
+      uint64_t t0 = Ticks::start();
+      body();
+      uint64_t t1 = Ticks::stop();
+      double net = static_cast<double>(t1 - t0) * Ticks::nanosecondsPerTick() - overhead;
+      stats.add(net);
+    }
+    return stats;
+  }
+}
@@ -0,0 +1,285 @@
+#ifndef STRINGSCAN_H
+#define STRINGSCAN_H
+///////////////////////////////////////////////////////////////////////
+// StringScan.h - vectorized delimiter scanning for split            //
+// ver 1.0                                                           //
+// Language:    C++20                                                //
+// Application: Most Projects, CSE687 - Object Oriented Design       //
+// Author:      Jim Fawcett, Syracuse University, CST 4-187          //
+//              jfawcett@twcny.rr.com                                //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides functions:
+* - findDelim(data, size, pos, delim)   index of next delim at or after pos,
+*                                        or size if there is none
+* - findDelimWith(kind, ...)            same, using a specific scanner
+* - bestScanKind()                      fastest scanner this CPU supports
+* - blockScanKind()                     scanner DelimScanner uses by default
+* - scanKindName(kind)                  "scalar", "sse2", or "avx2"
+* - DelimScanner                        successive delimiter positions,
+*                                        reusing each block's match mask
+*
+* Scanners compare 16 (SSE2) or 32 (AVX2) bytes per step, building a
+* bit mask of matching positions and reporting the lowest set bit.
+* findDelim chooses its scanner once, at first use, from the CPU's features.
+* Targets other than x86/x64 always use the portable scalar scanner.
+*
+* Required Files:
+* ---------------
+*   StringScan.h
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 17 Oct 2026
+* - first release
+*
+* Notes:
+* ------
+* - Designed to provide all functionality in header file.
+* - BenchSplit.cpp compares throughput of the scanners.
+*/
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define STRINGSCAN_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define STRINGSCAN_TARGET(isa)
+#else
+#define STRINGSCAN_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace Utilities
+{
+  enum class ScanKind { scalar, sse2, avx2 };
+
+  namespace ScanDetail
+  {
+    //----< index of lowest set bit, mask must not be zero >-----------
+
+    inline unsigned lowBit(uint64_t mask)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+      unsigned long index;
+      _BitScanForward64(&index, mask);
+      return static_cast<unsigned>(index);
+#else
+      return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+    }
+    //----< portable byte at a time scanner >--------------------------
+
+    inline size_t findScalar(const char* data, size_t size, size_t pos, char delim)
+    {
+      for (; pos < size; ++pos)
+      {
+        if (data[pos] == delim)
+          return pos;
+      }
+      return size;
+    }
+
+#ifdef STRINGSCAN_X86
+    //----< scan 16 bytes per step >-----------------------------------
+
+    STRINGSCAN_TARGET("sse2")
+    inline size_t findSse2(const char* data, size_t size, size_t pos, char delim)
+    {
+      const __m128i pattern = _mm_set1_epi8(delim);
+      for (; pos + 16 <= size; pos += 16)
+      {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+        if (mask != 0)
+          return pos + lowBit(mask);
+      }
+      return findScalar(data, size, pos, delim);
+    }
+    //----< scan 32 bytes per step >-----------------------------------
+
+    STRINGSCAN_TARGET("avx2")
+    inline size_t findAvx2(const char* data, size_t size, size_t pos, char delim)
+    {
+      const __m256i pattern = _mm256_set1_epi8(delim);
+      for (; pos + 32 <= size; pos += 32)
+      {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+        if (mask != 0)
+          return pos + lowBit(mask);
+      }
+      return findSse2(data, size, pos, delim);
+    }
+    //----< match mask for 16 bytes at p >-----------------------------
+
+    STRINGSCAN_TARGET("sse2")
+    inline uint32_t maskSse2(const char* p, char delim)
+    {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(delim))));
+    }
+    //----< match mask for 64 bytes at p, two 32 byte compares >-------
+    /*
+    *  - returning 64 bits per call amortizes the call into AVX2 code,
+    *    which can't be inlined into callers compiled without AVX2
+    */
+    STRINGSCAN_TARGET("avx2")
+    inline uint64_t maskAvx2(const char* p, char delim)
+    {
+      const __m256i pattern = _mm256_set1_epi8(delim);
+      __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+      uint32_t loMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, pattern)));
+      uint32_t hiMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, pattern)));
+      return (static_cast<uint64_t>(hiMask) << 32) | loMask;
+    }
+    //----< does the CPU, and the OS, support AVX2? >------------------
+
+    inline bool hasAvx2()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+      int info[4];
+      __cpuid(info, 0);
+      if (info[0] < 7)
+        return false;
+      __cpuid(info, 1);
+      bool osxsave = (info[2] & (1 << 27)) != 0;
+      bool avx = (info[2] & (1 << 28)) != 0;
+      if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+        return false;
+      __cpuidex(info, 7, 0);
+      return (info[1] & (1 << 5)) != 0;
+#else
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+  }
+  //----< fastest scanner supported by this CPU >----------------------
+
+  inline ScanKind bestScanKind()
+  {
+#ifdef STRINGSCAN_X86
+    static const ScanKind kind = ScanDetail::hasAvx2() ? ScanKind::avx2 : ScanKind::sse2;
+    return kind;
+#else
+    return ScanKind::scalar;
+#endif
+  }
+  //----< scanner used by DelimScanner for short tokens >-------------
+  /*
+  *  - AVX2 code called from code compiled without AVX2 can't be inlined,
+  *    and with short tokens that call costs more than the wider compare
+  *    saves, so use AVX2 only when the program is compiled for it
+  */
+  inline ScanKind blockScanKind()
+  {
+#if defined(__AVX2__)
+    return ScanKind::avx2;
+#elif defined(STRINGSCAN_X86)
+    return ScanKind::sse2;
+#else
+    return ScanKind::scalar;
+#endif
+  }
+  //----< display name of scanner >------------------------------------
+
+  inline const char* scanKindName(ScanKind kind)
+  {
+    switch (kind)
+    {
+    case ScanKind::sse2: return "sse2";
+    case ScanKind::avx2: return "avx2";
+    default: return "scalar";
+    }
+  }
+  //----< find next delim using a specific scanner >-------------------
+  /*
+  *  - falls back to scalar if kind is not available on this target
+  */
+  inline size_t findDelimWith(ScanKind kind, const char* data, size_t size, size_t pos, char delim)
+  {
+#ifdef STRINGSCAN_X86
+    switch (kind)
+    {
+    case ScanKind::avx2: return ScanDetail::findAvx2(data, size, pos, delim);
+    case ScanKind::sse2: return ScanDetail::findSse2(data, size, pos, delim);
+    default: break;
+    }
+#endif
+    return ScanDetail::findScalar(data, size, pos, delim);
+  }
+  //----< find next delim using the best scanner for this CPU >--------
+
+  inline size_t findDelim(const char* data, size_t size, size_t pos, char delim)
+  {
+    return findDelimWith(bestScanKind(), data, size, pos, delim);
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // DelimScanner - reports successive delimiter positions
+  // - keeps the match mask of the current 16 (SSE2) or 64 (AVX2) byte
+  //   block, so short tokens don't reload and recompare the same block
+
+  class DelimScanner
+  {
+  public:
+    DelimScanner() = default;
+    DelimScanner(const char* data, size_t size, char delim, ScanKind kind = blockScanKind())
+      : data_(data), size_(size), delim_(delim), kind_(kind)
+    {
+      width_ = (kind_ == ScanKind::avx2) ? 64 : 16;
+#ifndef STRINGSCAN_X86
+      kind_ = ScanKind::scalar;
+#endif
+    }
+    //----< index of next delim at or after pos, size if none >--------
+
+    size_t next(size_t pos)
+    {
+      if (kind_ == ScanKind::scalar)
+        return ScanDetail::findScalar(data_, size_, pos, delim_);
+      while (pos < size_)
+      {
+        if (pos < base_ || pos >= base_ + width_)
+        {
+          if (pos + width_ > size_)
+            return ScanDetail::findScalar(data_, size_, pos, delim_);
+          load(pos);
+        }
+        uint64_t mask = mask_ & (~uint64_t(0) << (pos - base_));
+        if (mask != 0)
+          return base_ + ScanDetail::lowBit(mask);
+        pos = base_ + width_;
+      }
+      return size_;
+    }
+  private:
+    //----< compute match mask for block starting at base >------------
+
+    void load(size_t base)
+    {
+      base_ = base;
+#ifdef STRINGSCAN_X86
+      if (kind_ == ScanKind::avx2)
+        mask_ = ScanDetail::maskAvx2(data_ + base, delim_);
+      else
+        mask_ = ScanDetail::maskSse2(data_ + base, delim_);
+#endif
+    }
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t base_ = ~size_t(0) >> 1;
+    size_t width_ = 16;
+    uint64_t mask_ = 0;
+    char delim_ = ',';
+    ScanKind kind_ = ScanKind::scalar;
+  };
+}
+#endif
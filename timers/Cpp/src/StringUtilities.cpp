@@ -1,6 +1,6 @@
 ///////////////////////////////////////////////////////////////////////
 // StringUtilities.cpp - small, generally useful, helper classes     //
-// ver 1.0                                                           //
+// ver 1.1                                                           //
 // Language:    C++, Visual Studio 2017                              //
 // Application: Most Projects, CSE687 - Object Oriented Design       //
 // Author:      Jim Fawcett, Syracuse University, CST 4-187          //
@@ -36,6 +36,31 @@ int main()
   result = split(test, ' ');
   showSplits(result);
 
+  title("test split_view(std::string, ',')");
+
+  std::cout << "\n  test string = " << test;
+  std::cout << "\n";
+  for (std::string_view token : split_view(test))
+    std::cout << "\n--" << (token == "\n" ? "newline" : token);
+  std::cout << "\n";
+
+  title("test split(std::string, \"::\")");
+
+  std::string mixed = "a,b; c\td :: e:f,,g";
+  std::cout << "\n  test string = " << mixed;
+  showSplits(split(mixed, "::"));
+
+  title("test split(std::string, DelimiterSet{ \",\", \";\", \"\\t\", \"::\" })");
+
+  constexpr DelimiterSet delims{ ",", ";", "\t", "::" };
+  std::cout << "\n  test string = " << mixed;
+  showSplits(split(mixed, delims));
+
+  title("test trim_view(std::string_view)");
+
+  std::string_view padded = "  \t trimmed text \t ";
+  std::cout << "\n  [" << trim_view(padded) << "]";
+
   putline(2);
   return 0;
 }
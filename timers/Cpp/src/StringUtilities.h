@@ -2,7 +2,7 @@
 #define STRINGUTILITIES_H
 ///////////////////////////////////////////////////////////////////////
 // StringUtilities.h - small, generally useful, helper classes       //
-// ver 1.0                                                           //
+// ver 1.2                                                           //
 // Language:    C++, Visual Studio 2017                              //
 // Application: Most Projects, CSE687 - Object Oriented Design       //
 // Author:      Jim Fawcett, Syracuse University, CST 4-187          //
@@ -16,15 +16,29 @@
 * - title(text)           display subtitle
 * - putline(n)            display n newlines
 * - trim(str)             remove leading and trailing whitespace
+* - trim_view(sv)         trim returning a slice of its argument, no allocation
 * - split(str, 'delim')   break string into vector of strings separated by delim char 
-* - showSplit(vector)     display splits
+* - split_view(str, 'delim')  lazy range of trimmed string_view slices, no allocation
+* - split(str, "delim")   split on a multi-character delimiter string
+* - split(str, DelimiterSet{ ",", ";", "::" })  split on any of several
+*                         delimiters in one pass, also for split_view
+* - showSplit(vector)     display splits, written with one stream call
+*
+* For input too large to hold in memory see SplitStream.h.
 *
 * Required Files:
 * ---------------
-*   StringUtilities.h
+*   StringUtilities.h, StringScan.h, OutBuffer.h
 *
 * Maintenance History:
 * --------------------
+* ver 1.2 : 17 Oct 2026
+* - showSplits formats into an OutBuffer, not one stream call per split
+* ver 1.1 : 17 Oct 2026
+* - added trim_view and split_view, returning string_view slices
+* - trim and split are now thin wrappers over the view functions
+* - char splits find delimiters with the vectorized scanners in StringScan.h
+* - added split on delimiter strings and on DelimiterSet
 * ver 1.0 : 12 Jan 2018
 * - first release
 
@@ -40,11 +54,20 @@
 * - none yet
 */
 #include <string>
+#include <string_view>
+#include <iterator>
+#include <cstddef>
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include <functional>
 #include <locale>
+#include <type_traits>
+#include <initializer_list>
+#include <stdexcept>
+#include <cstdint>
+#include "StringScan.h"
+#include "OutBuffer.h"
 
 namespace Utilities
 {
@@ -72,66 +95,359 @@ namespace Utilities
     for (size_t i = 0; i < j; ++i)
       out << "\n";
   }
+  /*--- is ch whitespace, other than newline? ------------------------------*/
+  /*
+  *  - same set as isspace(ch) in the classic locale, less '\n'
+  *  - avoids constructing a std::locale for every call
+  */
+  template <typename T>
+  inline bool isTrimSpace(T ch)
+  {
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f';
+  }
+  /*--- remove whitespace from front and back of string view ----------------*/
+  /*
+  *  - does not remove newlines
+  *  - returns a slice of the argument, so never allocates
+  */
+  template <typename T>
+  inline std::basic_string_view<T> trim_view(std::basic_string_view<T> toTrim)
+  {
+    size_t first = 0;
+    size_t last = toTrim.size();
+    while (first < last && isTrimSpace(toTrim[first]))
+      ++first;
+    while (last > first && isTrimSpace(toTrim[last - 1]))
+      --last;
+    return toTrim.substr(first, last - first);
+  }
   /*--- remove whitespace from front and back of string argument ---*/
   /*
   *  - does not remove newlines
+  *  - thin wrapper around trim_view
   */
   template <typename T>
   inline std::basic_string<T> trim(const std::basic_string<T>& toTrim)
   {
-    if (toTrim.size() == 0)
-      return toTrim;
-    std::basic_string<T> temp;
-    std::locale loc;
-    typename std::basic_string<T>::const_iterator iter = toTrim.begin();
-    while (isspace(*iter, loc) && *iter != '\n')
+    return std::basic_string<T>(trim_view(std::basic_string_view<T>(toTrim)));
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // Delimiter finders used by SplitRange
+  // - find(src, pos, len) returns the index of the next delimiter at or
+  //   after pos, or src.size() if there is none, and sets len to the
+  //   delimiter's length
+  // - reset(src) is called once, before the first find on src
+
+  /*--- single delimiter character ------------------------------------------*/
+  /*
+  *  - char sources are scanned 16 or 64 bytes at a time, see StringScan.h
+  */
+  template <typename T>
+  class CharFinder
+  {
+  public:
+    CharFinder(T splitOn = ',') : splitOn_(splitOn) {}
+    void reset(std::basic_string_view<T> src)
     {
-      if (++iter == toTrim.end())
+      if constexpr (std::is_same_v<T, char>)
+        scanner_ = DelimScanner(src.data(), src.size(), splitOn_);
+    }
+    size_t find(std::basic_string_view<T> src, size_t pos, size_t& len)
+    {
+      len = 1;
+      if constexpr (std::is_same_v<T, char>)
+      {
+        return scanner_.next(pos);
+      }
+      else
       {
-        break;
+        size_t end = src.find(splitOn_, pos);
+        return end == std::basic_string_view<T>::npos ? src.size() : end;
       }
     }
-    for (; iter != toTrim.end(); ++iter)
+  private:
+    T splitOn_;
+    DelimScanner scanner_;  // used only for char sources
+  };
+
+  /*--- multi-character delimiter string ------------------------------------*/
+  /*
+  *  - Boyer-Moore-Horspool search with a 256 entry skip table, built once
+  *  - characters wider than a byte share table entries by their low byte,
+  *    which only makes some skips shorter, never wrong
+  *  - the delimiter string must outlive the finder
+  */
+  template <typename T>
+  class StringFinder
+  {
+  public:
+    StringFinder(std::basic_string_view<T> delim = {}) : delim_(delim)
     {
-      temp += *iter;
+      size_t m = delim_.size();
+      uint8_t limit = static_cast<uint8_t>(m < 255 ? m : 255);
+      for (auto& shift : skip_)
+        shift = limit;
+      for (size_t i = 0; i + 1 < m; ++i)
+      {
+        size_t shift = m - 1 - i;
+        skip_[index(delim_[i])] = static_cast<uint8_t>(shift < limit ? shift : limit);
+      }
     }
-    typename std::basic_string<T>::reverse_iterator riter;
-    size_t pos = temp.size();
-    for (riter = temp.rbegin(); riter != temp.rend(); ++riter)
+    void reset(std::basic_string_view<T>) {}
+    size_t find(std::basic_string_view<T> src, size_t pos, size_t& len) const
     {
-      --pos;
-      if (!isspace(*riter, loc) || *riter == '\n')
+      size_t m = delim_.size();
+      len = m;
+      if (m == 0)
+        return src.size();
+      while (pos + m <= src.size())
       {
-        break;
+        T last = src[pos + m - 1];
+        if (last == delim_[m - 1] && src.compare(pos, m - 1, delim_.substr(0, m - 1)) == 0)
+          return pos;
+        pos += skip_[index(last)];
       }
+      return src.size();
     }
-    if (0 <= pos && pos < temp.size())
-      temp.erase(++pos);
-    return temp;
-  }
+  private:
+    static size_t index(T ch)
+    {
+      return static_cast<size_t>(static_cast<std::make_unsigned_t<T>>(ch)) & 0xFF;
+    }
+    std::basic_string_view<T> delim_;
+    uint8_t skip_[256];
+  };
 
-  /*--- split sentinel separated strings into a vector of trimmed strings ---*/
+  /////////////////////////////////////////////////////////////////////
+  // DelimiterSet - any of several char delimiters, in one pass
+  // - one character entries match that character, longer entries match
+  //   the whole string, e.g. DelimiterSet{ ",", ";", "\t", "::" }
+  // - a 256 entry table, built at construction, tells whether a char is
+  //   a delimiter or may start a longer one; constexpr instances are
+  //   built at compile time
+  // - at a position where several entries match, the longest wins
+  // - entry strings must outlive the set; literals always do
 
-  template <typename T>
-  inline std::vector<std::basic_string<T>> split(const std::basic_string<T>& toSplit, T splitOn = ',')
+  class DelimiterSet
   {
-    std::vector<std::basic_string<T>> splits;
-    std::basic_string<T> temp;
-    typename std::basic_string<T>::const_iterator iter;
-    for (iter = toSplit.begin(); iter != toSplit.end(); ++iter)
+  public:
+    static constexpr size_t maxMulti = 8;
+
+    constexpr DelimiterSet() = default;
+    constexpr DelimiterSet(std::initializer_list<std::string_view> delims)
     {
-      if (*iter != splitOn)
+      for (std::string_view delim : delims)
       {
-        temp += *iter;
+        if (delim.size() == 1)
+        {
+          table_[index(delim[0])] |= single;
+        }
+        else if (delim.size() > 1)
+        {
+          if (multiCount_ == maxMulti)
+            throw std::length_error("DelimiterSet: too many multi-character delimiters");
+          table_[index(delim[0])] |= starts;
+          size_t i = multiCount_++;
+          for (; i > 0 && multi_[i - 1].size() < delim.size(); --i)  // longest first
+            multi_[i] = multi_[i - 1];
+          multi_[i] = delim;
+        }
       }
-      else
+    }
+    //----< set matching any one of the characters in chars >------------
+
+    static constexpr DelimiterSet anyOf(std::string_view chars)
+    {
+      DelimiterSet set{};
+      for (char ch : chars)
+        set.table_[index(ch)] |= single;
+      return set;
+    }
+    constexpr bool isDelimiter(char ch) const { return (table_[index(ch)] & single) != 0; }
+
+    void reset(std::string_view) {}
+    constexpr size_t find(std::string_view src, size_t pos, size_t& len) const
+    {
+      for (; pos < src.size(); ++pos)
       {
-        splits.push_back(trim(temp));
-        temp.clear();
+        uint8_t kind = table_[index(src[pos])];
+        if (kind == 0)
+          continue;
+        if (kind & starts)
+        {
+          for (size_t i = 0; i < multiCount_; ++i)
+          {
+            if (src.compare(pos, multi_[i].size(), multi_[i]) == 0)
+            {
+              len = multi_[i].size();
+              return pos;
+            }
+          }
+        }
+        if (kind & single)
+        {
+          len = 1;
+          return pos;
+        }
       }
+      len = 1;
+      return src.size();
     }
-    if (temp.length() > 0)
-      splits.push_back(trim(temp));
+  private:
+    static constexpr uint8_t single = 1;
+    static constexpr uint8_t starts = 2;
+    static constexpr size_t index(char ch) { return static_cast<unsigned char>(ch); }
+
+    uint8_t table_[256] = {};
+    std::string_view multi_[maxMulti] = {};
+    size_t multiCount_ = 0;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // SplitRange<T, Finder> - lazy range of trimmed slices between delimiters
+  // - iterators yield std::basic_string_view<T> into the source string,
+  //   so the source must outlive the range
+  // - yields the same tokens as split(str, splitOn): a trailing token is
+  //   produced only if there are characters after the last delimiter
+  // - Finder locates delimiters, see CharFinder, StringFinder, DelimiterSet
+
+  template <typename T, typename Finder = CharFinder<T>>
+  class SplitRange
+  {
+  public:
+    using View = std::basic_string_view<T>;
+
+    class iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = View;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const View*;
+      using reference = View;
+
+      iterator() = default;
+      iterator(View src, const Finder& finder) : src_(src), finder_(finder), done_(src.empty())
+      {
+        finder_.reset(src_);
+        if (!done_)
+          next();
+      }
+      View operator*() const { return trim_view(token_); }
+      iterator& operator++()
+      {
+        if (pos_ > src_.size())
+          done_ = true;
+        else
+          next();
+        return *this;
+      }
+      iterator operator++(int) { iterator temp = *this; ++*this; return temp; }
+      bool operator==(const iterator& other) const
+      {
+        if (done_ || other.done_)
+          return done_ == other.done_;
+        return pos_ == other.pos_;
+      }
+      bool operator!=(const iterator& other) const { return !(*this == other); }
+    private:
+      /*--- find next token, pos_ is one past its delimiter ---*/
+      void next()
+      {
+        if (pos_ >= src_.size())  // nothing after last delimiter
+        {
+          done_ = true;
+          return;
+        }
+        size_t len = 1;
+        size_t end = finder_.find(src_, pos_, len);
+        token_ = src_.substr(pos_, end - pos_);
+        pos_ = end < src_.size() ? end + len : src_.size() + 1;
+      }
+      View src_;
+      View token_;
+      size_t pos_ = 0;
+      Finder finder_;
+      bool done_ = true;
+    };
+
+    SplitRange(View src, const Finder& finder) : src_(src), finder_(finder) {}
+    iterator begin() const { return iterator(src_, finder_); }
+    iterator end() const { return iterator(); }
+  private:
+    View src_;
+    Finder finder_;
+  };
+
+  /*--- lazily split sentinel separated string into trimmed slices ---------*/
+
+  template <typename T>
+  inline SplitRange<T> split_view(std::basic_string_view<T> toSplit, T splitOn = ',')
+  {
+    return SplitRange<T>(toSplit, CharFinder<T>(splitOn));
+  }
+
+  template <typename T>
+  inline SplitRange<T> split_view(const std::basic_string<T>& toSplit, T splitOn = ',')
+  {
+    return SplitRange<T>(std::basic_string_view<T>(toSplit), CharFinder<T>(splitOn));
+  }
+  /*--- lazily split on a multi-character delimiter string ------------------*/
+
+  template <typename T>
+  inline SplitRange<T, StringFinder<T>> split_view(
+    std::basic_string_view<T> toSplit, std::type_identity_t<std::basic_string_view<T>> delim
+  )
+  {
+    return SplitRange<T, StringFinder<T>>(toSplit, StringFinder<T>(delim));
+  }
+
+  template <typename T>
+  inline SplitRange<T, StringFinder<T>> split_view(
+    const std::basic_string<T>& toSplit, std::type_identity_t<std::basic_string_view<T>> delim
+  )
+  {
+    return SplitRange<T, StringFinder<T>>(std::basic_string_view<T>(toSplit), StringFinder<T>(delim));
+  }
+  /*--- lazily split on any delimiter in a set ------------------------------*/
+
+  inline SplitRange<char, DelimiterSet> split_view(std::string_view toSplit, const DelimiterSet& delims)
+  {
+    return SplitRange<char, DelimiterSet>(toSplit, delims);
+  }
+
+  /*--- split sentinel separated strings into a vector of trimmed strings ---*/
+  /*
+  *  - thin wrapper around split_view, one allocation per token
+  */
+  template <typename T>
+  inline std::vector<std::basic_string<T>> split(const std::basic_string<T>& toSplit, T splitOn = ',')
+  {
+    std::vector<std::basic_string<T>> splits;
+    for (auto token : split_view(toSplit, splitOn))
+      splits.emplace_back(token);
+    return splits;
+  }
+  /*--- split on a multi-character delimiter string -------------------------*/
+
+  template <typename T>
+  inline std::vector<std::basic_string<T>> split(
+    const std::basic_string<T>& toSplit, std::type_identity_t<std::basic_string_view<T>> delim
+  )
+  {
+    std::vector<std::basic_string<T>> splits;
+    for (auto token : split_view(toSplit, delim))
+      splits.emplace_back(token);
+    return splits;
+  }
+  /*--- split on any delimiter in a set, in one pass ------------------------*/
+
+  inline std::vector<std::string> split(const std::string& toSplit, const DelimiterSet& delims)
+  {
+    std::vector<std::string> splits;
+    for (auto token : split_view(toSplit, delims))
+      splits.emplace_back(token);
     return splits;
   }
   /*--- show collection of string splits ------------------------------------*/
@@ -139,15 +455,16 @@ namespace Utilities
   template <typename T>
   inline void showSplits(const std::vector<std::basic_string<T>>& splits, std::ostream& out = std::cout)
   {
-    out << "\n";
-    for (auto item : splits)
+    OutBuffer buffer(out);
+    buffer << "\n";
+    for (auto& item : splits)
     {
       if (item == "\n")
-        out << "\n--" << "newline";
+        buffer << "\n--" << "newline";
       else
-        out << "\n--" << item;
+        buffer << "\n--" << item;
     }
-    out << "\n";
+    buffer << "\n";
   }
 }
 #endif
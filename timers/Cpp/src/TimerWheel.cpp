@@ -0,0 +1,395 @@
+/////////////////////////////////////////////////////////////////////
+// TimerWheel.cpp - schedule callbacks with a hierarchical wheel   //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+
+#include "TimerWheel.h"
+#include <algorithm>
+#include <bit>
+
+using namespace Utilities;
+
+//----< empty wheel at tick 0 >--------------------------------------
+
+TimerWheel::TimerWheel()
+{
+  std::fill(std::begin(heads_), std::end(heads_), none);
+  for (auto& level : occupied_)
+    std::fill(std::begin(level), std::end(level), 0);
+}
+//----< take a node from the free list, or grow the pool >-----------
+
+uint32_t TimerWheel::allocate()
+{
+  if (free_ != none)
+  {
+    uint32_t node = free_;
+    free_ = nodes_[node].next;
+    return node;
+  }
+  nodes_.emplace_back();
+  return static_cast<uint32_t>(nodes_.size() - 1);
+}
+//----< return node to the free list, invalidating its TimerIds >----
+
+void TimerWheel::release(uint32_t node)
+{
+  Node& n = nodes_[node];
+  n.callback = nullptr;
+  n.bucket = none;
+  ++n.generation;
+  n.next = free_;
+  free_ = node;
+  --pending_;
+}
+//----< put node in the slot for its expiry >------------------------
+/*
+ * A timer goes in the finest level whose span covers its delay, in the
+ * slot its expiry falls in.  It is cascaded when time reaches the start
+ * of that slot, which is after now and no later than the expiry.
+ * Expired timers, met only while cascading, go in the current slot.
+ */
+void TimerWheel::link(uint32_t node)
+{
+  Node& n = nodes_[node];
+  constexpr uint64_t span = uint64_t(1) << (slotBits * levels);
+  uint64_t place = std::max(n.expiry, now_);
+  if (place - now_ >= span)
+    place = now_ + span - 1;  // park in level 3, placed again later
+  uint64_t delta = place - now_;
+  size_t level = 0;
+  while (level + 1 < levels && delta >= (uint64_t(1) << (slotBits * (level + 1))))
+    ++level;
+  size_t slot = static_cast<size_t>(place >> (slotBits * level)) & mask;
+
+  uint32_t bucket = static_cast<uint32_t>(level * slots + slot);
+  n.bucket = bucket;
+  n.prev = none;
+  n.next = heads_[bucket];
+  if (n.next != none)
+    nodes_[n.next].prev = node;
+  heads_[bucket] = node;
+  occupied_[level][slot / 64] |= uint64_t(1) << (slot % 64);
+}
+//----< take node out of its slot >----------------------------------
+
+void TimerWheel::unlink(uint32_t node)
+{
+  Node& n = nodes_[node];
+  if (n.prev != none)
+    nodes_[n.prev].next = n.next;
+  else
+    heads_[n.bucket] = n.next;
+  if (n.next != none)
+    nodes_[n.next].prev = n.prev;
+  if (heads_[n.bucket] == none)
+  {
+    size_t level = n.bucket / slots;
+    size_t slot = n.bucket % slots;
+    occupied_[level][slot / 64] &= ~(uint64_t(1) << (slot % 64));
+  }
+}
+//----< add a timer firing at tick, or next advance if tick is past >
+
+TimerId TimerWheel::scheduleAt(uint64_t tick, Callback callback)
+{
+  uint32_t node = allocate();
+  Node& n = nodes_[node];
+  n.callback = std::move(callback);
+  n.expiry = std::max(tick, now_ + 1);
+  link(node);
+  ++pending_;
+  return TimerId{ node, n.generation };
+}
+//----< remove a pending timer, false if it fired or was cancelled >-
+
+bool TimerWheel::cancel(TimerId id)
+{
+  if (id.index >= nodes_.size())
+    return false;
+  Node& n = nodes_[id.index];
+  if (n.generation != id.generation || n.bucket == none)
+    return false;
+  unlink(id.index);
+  release(id.index);
+  return true;
+}
+//----< first occupied level 0 slot at or after from, or -1 >--------
+
+int TimerWheel::firstOccupied(size_t from) const
+{
+  size_t word = from / 64;
+  uint64_t bits = occupied_[0][word] & (~uint64_t(0) << (from % 64));
+  while (true)
+  {
+    if (bits != 0)
+      return static_cast<int>(word * 64 + std::countr_zero(bits));
+    if (++word == slots / 64)
+      return -1;
+    bits = occupied_[0][word];
+  }
+}
+//----< next tick where advance has work, or never >-----------------
+/*
+ * That is the next occupied level 0 slot in this turn of the wheel,
+ * else the start of the next turn, where coarser wheels cascade.
+ */
+uint64_t TimerWheel::nextEvent() const
+{
+  if (pending_ == 0)
+    return never;
+  uint64_t tick = now_ + 1;
+  if ((tick & mask) == 0)
+    return tick;
+  uint64_t base = tick & ~uint64_t(mask);
+  int slot = firstOccupied(static_cast<size_t>(tick & mask));
+  return slot < 0 ? base + slots : base + static_cast<uint64_t>(slot);
+}
+//----< refill finer wheels from this level's current slot >---------
+
+void TimerWheel::cascade(size_t level)
+{
+  size_t slot = static_cast<size_t>(now_ >> (slotBits * level)) & mask;
+  if (slot == 0 && level + 1 < levels)
+    cascade(level + 1);
+  uint32_t& head = heads_[level * slots + slot];
+  while (head != none)
+  {
+    uint32_t node = head;
+    unlink(node);
+    link(node);
+  }
+}
+//----< move callbacks of level 0 slot to due >----------------------
+
+size_t TimerWheel::expire(size_t slot, std::vector<Callback>& due)
+{
+  size_t fired = 0;
+  uint32_t& head = heads_[slot];
+  while (head != none)
+  {
+    uint32_t node = head;
+    unlink(node);
+    due.push_back(std::move(nodes_[node].callback));
+    release(node);
+    ++fired;
+  }
+  return fired;
+}
+//----< move time to tick, appending callbacks due to due >----------
+
+size_t TimerWheel::advance(uint64_t tick, std::vector<Callback>& due)
+{
+  size_t fired = 0;
+  while (now_ < tick)
+  {
+    uint64_t next = nextEvent();
+    if (next > tick)
+    {
+      now_ = tick;
+      break;
+    }
+    now_ = next;
+    size_t slot = static_cast<size_t>(now_ & mask);
+    if (slot == 0)
+      cascade(1);
+    fired += expire(slot, due);
+  }
+  return fired;
+}
+//----< move time to tick, running callbacks due >-------------------
+/*
+ * Callbacks run after the wheel reaches tick, so they may schedule
+ * and cancel timers.  The due list is a spare kept between calls, so
+ * steady firing doesn't allocate; a nested advance gets its own.
+ */
+size_t TimerWheel::advance(uint64_t tick)
+{
+  std::vector<Callback> due;
+  due.swap(spare_);
+  size_t fired = advance(tick, due);
+  for (auto& callback : due)
+    callback();
+  due.clear();
+  spare_.swap(due);
+  return fired;
+}
+
+//----< start driver thread >----------------------------------------
+
+TimerService::TimerService() : start_(Clock::now())
+{
+  driver_ = std::thread(&TimerService::run, this);
+}
+//----< stop driver thread, dropping pending timers >----------------
+
+TimerService::~TimerService()
+{
+  stop();
+}
+
+void TimerService::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stopping_ = true;
+  }
+  cv_.notify_one();
+  if (driver_.joinable() && driver_.get_id() != std::this_thread::get_id())
+    driver_.join();
+}
+//----< milliseconds since the service started >---------------------
+
+uint64_t TimerService::tickNow() const
+{
+  auto since = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_);
+  return static_cast<uint64_t>(since.count());
+}
+//----< add timer, waking the driver if it fires before the wake >---
+/*
+ * Delays count from now, not from the wheel's last tick, which lags
+ * while the driver sleeps.
+ */
+TimerId TimerService::scheduleTicks(uint64_t delayTicks, Callback callback)
+{
+  uint64_t tick = tickNow() + delayTicks;
+  bool wake = false;
+  TimerId id;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    id = wheel_.scheduleAt(tick, std::move(callback));
+    wake = tick < wakeTick_;
+  }
+  if (wake)
+    cv_.notify_one();
+  return id;
+}
+//----< remove pending timer, false if it fired or is firing >-------
+
+bool TimerService::cancel(TimerId id)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return wheel_.cancel(id);
+}
+
+size_t TimerService::pending()
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return wheel_.pending();
+}
+//----< driver: advance to now, run due callbacks unlocked, sleep >--
+
+void TimerService::run()
+{
+  std::vector<Callback> due;
+  std::unique_lock<std::mutex> lock(mtx_);
+  while (!stopping_)
+  {
+    wheel_.advance(tickNow(), due);
+    if (!due.empty())
+    {
+      wakeTick_ = 0;  // busy, schedule need not notify
+      lock.unlock();
+      for (auto& callback : due)
+        callback();
+      due.clear();
+      lock.lock();
+      continue;
+    }
+    wakeTick_ = wheel_.nextEvent();
+    if (wakeTick_ == TimerWheel::never)
+      cv_.wait(lock);
+    else
+      cv_.wait_until(lock, start_ + std::chrono::milliseconds(wakeTick_));
+  }
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TIMERWHEEL
+
+#include <iostream>
+#include <random>
+#include <atomic>
+#include "StringUtilities.h"
+
+/*-- fire random timers in big steps, checking each fires in its step --*/
+size_t checkWheel(size_t count)
+{
+  TimerWheel wheel;
+  std::mt19937_64 rng(42);
+  std::vector<uint64_t> expected(count), fired(count, 0);
+  std::vector<TimerId> ids(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    expected[i] = 1 + rng() % (uint64_t(1) << (rng() % 34));  // up to 198 days
+    ids[i] = wheel.schedule(expected[i], [&, i] { fired[i] = wheel.now(); });
+  }
+  size_t errors = 0;
+  for (size_t i = 0; i < count; i += 3)
+    if (!wheel.cancel(ids[i]) || wheel.cancel(ids[i]))
+      ++errors;
+  uint64_t tick = 0;
+  while (wheel.pending() > 0)
+  {
+    tick += 1 + rng() % 5000000;
+    wheel.advance(tick);
+  }
+  for (size_t i = 0; i < count; ++i)
+  {
+    bool cancelled = i % 3 == 0;
+    if (cancelled ? fired[i] != 0 : fired[i] < expected[i] || fired[i] > expected[i] + 5000000)
+      ++errors;
+  }
+  return errors;
+}
+
+/*-- same, advancing one tick at a time over a shorter range --*/
+size_t checkExact(size_t count)
+{
+  TimerWheel wheel;
+  std::mt19937_64 rng(7);
+  std::vector<uint64_t> expected(count), fired(count, 0);
+  for (size_t i = 0; i < count; ++i)
+  {
+    expected[i] = 1 + rng() % 200000;
+    wheel.schedule(expected[i], [&, i] { fired[i] = wheel.now(); });
+  }
+  for (uint64_t tick = 1; wheel.pending() > 0; ++tick)
+    wheel.advance(tick);
+  size_t errors = 0;
+  for (size_t i = 0; i < count; ++i)
+    if (fired[i] != expected[i])
+      ++errors;
+  return errors;
+}
+
+int main()
+{
+  Utilities::Title("Testing TimerWheel");
+
+  std::cout << "\n  exact firing errors:  " << checkExact(100000);
+  std::cout << "\n  random firing errors: " << checkWheel(300000);
+
+  std::cout << "\n\n  TimerService, timers at 30, 10, and 20 millisecs, 40 cancelled";
+  std::atomic<int> count{ 0 };
+  auto start = TimerService::Clock::now();
+  auto report = [&](int ms) {
+    return [&, ms] {
+      auto et = std::chrono::duration_cast<std::chrono::microseconds>(TimerService::Clock::now() - start);
+      std::cout << "\n  " << ms << " millisec timer fired at " << et.count() << " microsecs";
+      ++count;
+    };
+  };
+  TimerService timers;
+  timers.schedule(std::chrono::milliseconds(30), report(30));
+  timers.schedule(std::chrono::milliseconds(10), report(10));
+  timers.schedule(std::chrono::milliseconds(20), report(20));
+  TimerId late = timers.schedule(std::chrono::milliseconds(40), report(40));
+  std::cout << "\n  cancelled: " << (timers.cancel(late) ? "yes" : "no");
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  std::cout << "\n  fired " << count << " of 3, pending " << timers.pending();
+  std::cout << "\n\n";
+}
+#endif
@@ -0,0 +1,159 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// TimerWheel.h - schedule callbacks with a hierarchical wheel     //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+/*
+ * Package Operations:
+ * -------------------
+ * TimerWheel holds pending callbacks in four wheels of 256 slots each,
+ * with millisecond ticks.  Level 0 slots are one tick wide, level 1
+ * slots 256 ticks, level 2 slots 65536 ticks, and level 3 slots about
+ * 4.7 hours, so the wheels span 49.7 days.  Longer delays park in
+ * level 3 and are placed again as they come into range.
+ * - schedule and cancel are O(1): a timer is a node in a pooled,
+ *   index linked list, found by its TimerId without searching
+ * - advance(tick) moves time forward, cascading timers from coarser
+ *   wheels to finer as their slots come up, and hands back the due
+ *   callbacks.  It skips empty slots using occupancy bitmaps.
+ * TimerWheel is single threaded, and has no clock of its own.
+ *
+ * TimerService drives a TimerWheel from steady_clock on one thread,
+ * which sleeps until the next occupied slot, and runs callbacks
+ * outside its lock, so they may schedule and cancel timers.
+ *
+ *   TimerService timers;
+ *   auto id = timers.schedule(DateTime::makeDuration(0, 0, 5), [] { ... });
+ *   timers.cancel(id);      // false if it already fired
+ *
+ * Required Files:
+ * ---------------
+ *   TimerWheel.h, TimerWheel.cpp
+ *
+ * Maintenance History:
+ * --------------------
+ * ver 1.0 : 17 Oct 2026
+ * - first release
+*/
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utilities
+{
+  struct TimerId
+  {
+    uint32_t index = std::numeric_limits<uint32_t>::max();
+    uint32_t generation = 0;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // TimerWheel - hierarchical timing wheel, ticks are milliseconds
+
+  class TimerWheel
+  {
+  public:
+    using Callback = std::function<void()>;
+    static constexpr size_t slotBits = 8;
+    static constexpr size_t slots = size_t(1) << slotBits;
+    static constexpr size_t levels = 4;
+    static constexpr uint64_t never = std::numeric_limits<uint64_t>::max();
+
+    TimerWheel();
+
+    TimerId scheduleAt(uint64_t tick, Callback callback);
+    TimerId schedule(uint64_t delayTicks, Callback callback)
+    {
+      return scheduleAt(now_ + delayTicks, std::move(callback));
+    }
+    template <typename Rep, typename Period>
+    TimerId schedule(std::chrono::duration<Rep, Period> delay, Callback callback)
+    {
+      auto ticks = std::chrono::ceil<std::chrono::milliseconds>(delay).count();
+      return schedule(static_cast<uint64_t>(ticks > 0 ? ticks : 0), std::move(callback));
+    }
+    bool cancel(TimerId id);
+
+    size_t advance(uint64_t tick, std::vector<Callback>& due);
+    size_t advance(uint64_t tick);
+    uint64_t nextEvent() const;
+
+    uint64_t now() const { return now_; }
+    size_t pending() const { return pending_; }
+    void reserve(size_t timers) { nodes_.reserve(timers); }
+  private:
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t mask = slots - 1;
+
+    struct Node
+    {
+      Callback callback;
+      uint64_t expiry = 0;
+      uint32_t next = none;
+      uint32_t prev = none;
+      uint32_t generation = 0;
+      uint32_t bucket = none;  // level * slots + slot, none when free
+    };
+    uint32_t allocate();
+    void release(uint32_t node);
+    void link(uint32_t node);
+    void unlink(uint32_t node);
+    void cascade(size_t level);
+    size_t expire(size_t slot, std::vector<Callback>& due);
+    int firstOccupied(size_t from) const;
+
+    std::vector<Node> nodes_;
+    std::vector<Callback> spare_;
+    uint32_t free_ = none;
+    uint32_t heads_[levels * slots];
+    uint64_t occupied_[levels][slots / 64];
+    uint64_t now_ = 0;
+    size_t pending_ = 0;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // TimerService - TimerWheel driven by steady_clock on its own thread
+  // - callbacks run on the driver thread, one at a time
+  // - timers still pending when the service stops never run
+
+  class TimerService
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = TimerWheel::Callback;
+
+    TimerService();
+    ~TimerService();
+    TimerService(const TimerService&) = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+    template <typename Rep, typename Period>
+    TimerId schedule(std::chrono::duration<Rep, Period> delay, Callback callback)
+    {
+      auto ticks = std::chrono::ceil<std::chrono::milliseconds>(delay).count();
+      return scheduleTicks(static_cast<uint64_t>(ticks > 0 ? ticks : 0), std::move(callback));
+    }
+    bool cancel(TimerId id);
+    size_t pending();
+    void stop();
+  private:
+    TimerId scheduleTicks(uint64_t delayTicks, Callback callback);
+    uint64_t tickNow() const;
+    void run();
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    TimerWheel wheel_;
+    Clock::time_point start_;
+    uint64_t wakeTick_ = TimerWheel::never;
+    bool stopping_ = false;
+    std::thread driver_;
+  };
+}
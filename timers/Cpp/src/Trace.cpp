@@ -0,0 +1,275 @@
+/////////////////////////////////////////////////////////////////////
+// Trace.cpp - record timed spans for Chrome tracing and Perfetto  //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+
+#include "Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace Utilities;
+
+//----< per-thread rings and the registry of threads >---------------
+/*
+ * Only the owning thread writes a ring.  It fills the slot, then
+ * publishes it by storing head with release.  A reader copies the
+ * slots below head, then reloads head: any slot the writer may have
+ * reused meanwhile is older than the new head less the capacity, and
+ * is dropped.
+ */
+namespace
+{
+  struct Event
+  {
+    std::atomic<const char*> name{ nullptr };
+    std::atomic<uint64_t> start{ 0 };
+    std::atomic<uint64_t> end{ 0 };
+  };
+
+  struct ThreadRing
+  {
+    explicit ThreadRing(uint32_t id) : tid(id), events(new Event[TraceRecorder::ringCapacity]) {}
+    uint32_t tid;
+    std::string name;  // guarded by Registry::mtx
+    std::unique_ptr<Event[]> events;
+    std::atomic<uint64_t> head{ 0 };
+  };
+
+  struct Registry
+  {
+    std::mutex mtx;
+    std::vector<std::shared_ptr<ThreadRing>> threads;
+  };
+
+  std::atomic<bool> tracing{ true };
+
+  Registry& registry()
+  {
+    static Registry instance;
+    return instance;
+  }
+
+  ThreadRing& threadRing()
+  {
+    thread_local std::shared_ptr<ThreadRing> local = [] {
+      Registry& reg = registry();
+      std::lock_guard<std::mutex> lock(reg.mtx);
+      auto ring = std::make_shared<ThreadRing>(static_cast<uint32_t>(reg.threads.size() + 1));
+      reg.threads.push_back(ring);
+      return ring;
+    }();
+    return *local;
+  }
+
+  struct Span
+  {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+    uint32_t tid;
+  };
+
+  /*-- append ring's readable spans to spans --*/
+  void collect(const ThreadRing& ring, std::vector<Span>& spans)
+  {
+    constexpr uint64_t capacity = TraceRecorder::ringCapacity;
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+    uint64_t first = head > capacity ? head - capacity : 0;
+    size_t base = spans.size();
+    for (uint64_t i = first; i < head; ++i)
+    {
+      const Event& e = ring.events[i % capacity];
+      spans.push_back(Span{
+        e.name.load(std::memory_order_relaxed),
+        e.start.load(std::memory_order_relaxed),
+        e.end.load(std::memory_order_relaxed),
+        ring.tid
+      });
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t after = ring.head.load(std::memory_order_relaxed);
+    uint64_t reused = after >= capacity ? after - capacity + 1 : 0;  // first slot still intact
+    if (reused > first)
+    {
+      size_t drop = static_cast<size_t>(std::min(reused - first, head - first));
+      spans.erase(spans.begin() + base, spans.begin() + base + drop);
+    }
+  }
+
+  void putQuoted(std::ostream& out, const char* text)
+  {
+    out << '"';
+    for (const char* p = text ? text : ""; *p; ++p)
+    {
+      if (*p == '"' || *p == '\\')
+        out << '\\';
+      if (static_cast<unsigned char>(*p) >= 0x20)
+        out << *p;
+    }
+    out << '"';
+  }
+}
+//----< append a span to this thread's ring >------------------------
+
+void TraceRecorder::record(const char* name, uint64_t startNs, uint64_t endNs)
+{
+  if (!tracing.load(std::memory_order_relaxed))
+    return;
+  ThreadRing& ring = threadRing();
+  uint64_t head = ring.head.load(std::memory_order_relaxed);
+  Event& e = ring.events[head % ringCapacity];
+  /* pairs with collect's acquire fence: a reader seeing any new field
+     then sees head, so drops the slot as overwritten */
+  std::atomic_thread_fence(std::memory_order_release);
+  e.name.store(name, std::memory_order_relaxed);
+  e.start.store(startNs, std::memory_order_relaxed);
+  e.end.store(endNs, std::memory_order_relaxed);
+  ring.head.store(head + 1, std::memory_order_release);
+}
+//----< name this thread's track in the trace viewer >---------------
+
+void TraceRecorder::nameThread(const std::string& name)
+{
+  ThreadRing& ring = threadRing();
+  std::lock_guard<std::mutex> lock(registry().mtx);
+  ring.name = name;
+}
+//----< turn recording on or off at run time, on by default >--------
+
+void TraceRecorder::setEnabled(bool enabled)
+{
+  tracing.store(enabled, std::memory_order_relaxed);
+}
+
+bool TraceRecorder::enabled()
+{
+  return tracing.load(std::memory_order_relaxed);
+}
+//----< write all threads' spans as Chrome trace_event JSON >--------
+/*
+ * Spans are complete ("X") events with times in microseconds from the
+ * earliest span, and each named thread gets a thread_name metadata
+ * event.  Returns the number of spans written.
+ */
+size_t TraceRecorder::writeJson(std::ostream& out)
+{
+  std::vector<Span> spans;
+  std::vector<std::pair<uint32_t, std::string>> names;
+  {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mtx);
+    for (auto& ring : reg.threads)
+    {
+      collect(*ring, spans);
+      if (!ring->name.empty())
+        names.emplace_back(ring->tid, ring->name);
+    }
+  }
+  uint64_t origin = ~uint64_t(0);
+  for (auto& span : spans)
+    origin = std::min(origin, span.start);
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (auto& [tid, name] : names)
+  {
+    out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+        << ",\"args\":{\"name\":";
+    putQuoted(out, name.c_str());
+    out << "}}";
+    first = false;
+  }
+  out << std::fixed << std::setprecision(3);
+  for (auto& span : spans)
+  {
+    out << (first ? "\n" : ",\n") << "{\"name\":";
+    putQuoted(out, span.name);
+    out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << span.tid
+        << ",\"ts\":" << static_cast<double>(span.start - origin) / 1000.0
+        << ",\"dur\":" << static_cast<double>(span.end - span.start) / 1000.0 << "}";
+    first = false;
+  }
+  out << "\n]}\n";
+  return spans.size();
+}
+//----< write trace to file at path, false if it can't be opened >---
+
+bool TraceRecorder::save(const std::string& path)
+{
+  std::ofstream out(path);
+  if (!out)
+    return false;
+  writeJson(out);
+  return static_cast<bool>(out);
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TRACE
+
+#include <sstream>
+#include <thread>
+#include "StringUtilities.h"
+
+uint64_t leaf(size_t n)
+{
+  TRACE_SCOPE("leaf");
+  uint64_t sum = 0;
+  for (size_t i = 0; i < n; ++i)
+    sum += i ^ (sum << 1);
+  return sum;
+}
+
+uint64_t branch(size_t n)
+{
+  TRACE_SCOPE("branch");
+  return leaf(n) + leaf(2 * n);
+}
+
+int main()
+{
+  Utilities::Title("Testing Trace");
+  TraceRecorder::nameThread("main");
+
+  std::atomic<uint64_t> sink = 0;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 3; ++t)
+    threads.emplace_back([&sink, t] {
+      TraceRecorder::nameThread("worker " + std::to_string(t));
+      uint64_t sum = 0;
+      for (size_t i = 0; i < 2000; ++i)
+        sum += branch(500 + 100 * t);
+      sink += sum;
+    });
+  {
+    TRACE_SCOPE("main waits");
+    for (int i = 0; i < 20; ++i)
+    {
+      std::ostringstream out;  // snapshot while workers record
+      TraceRecorder::writeJson(out);
+    }
+    for (auto& thread : threads)
+      thread.join();
+  }
+  Stopwatch sw;
+  sw.start();
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    TRACE_SCOPE("empty");
+  }
+  sw.stop();
+  std::cout << "\n  cost of an empty TRACE_SCOPE: " << sw.elapsedNanoseconds() / 100000.0 << " nanosecs";
+
+  std::ostringstream out;
+  size_t spans = TraceRecorder::writeJson(out);
+  std::cout << "\n  spans in trace: " << spans << " (rings keep the last " << TraceRecorder::ringCapacity << " per thread)";
+  std::cout << "\n  saved trace.json: " << (TraceRecorder::save("trace.json") ? "yes" : "no");
+  std::cout << "\n  open it at https://ui.perfetto.dev or chrome://tracing\n\n";
+}
+#endif
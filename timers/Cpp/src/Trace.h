@@ -0,0 +1,89 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// Trace.h - record timed spans for Chrome tracing and Perfetto    //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2026         //
+/////////////////////////////////////////////////////////////////////
+/*
+ * Package Operations:
+ * -------------------
+ * Records named spans of time on every thread and writes them as
+ * Chrome trace_event JSON, which chrome://tracing and ui.perfetto.dev
+ * open offline, showing one track per thread.
+ *
+ *   void handle() {
+ *     TRACE_SCOPE("handle");          // span covers rest of block
+ *     ...
+ *   }
+ *   TraceRecorder::nameThread("main");
+ *   TraceRecorder::save("trace.json");
+ *
+ * - TraceSpan reads steady_clock when constructed and destroyed, then
+ *   appends one event to its thread's ring buffer, with no locks.
+ * - Each ring holds the latest ringCapacity spans of its thread,
+ *   overwriting the oldest, so tracing long runs keeps the end.
+ * - Rings outlive their threads, and writeJson may run while other
+ *   threads record; spans overwritten during the write are dropped.
+ * - Span names are stored as pointers, so must be string literals
+ *   or otherwise outlive the recorder.
+ *
+ * Define TRACE_DISABLED to compile TRACE_SCOPE to nothing.
+ *
+ * Required Files:
+ * ---------------
+ *   Trace.h, Trace.cpp, Stopwatch.h
+ *
+ * Maintenance History:
+ * --------------------
+ * ver 1.0 : 17 Oct 2026
+ * - first release
+*/
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "Stopwatch.h"
+
+namespace Utilities
+{
+  /////////////////////////////////////////////////////////////////////
+  // TraceRecorder - per-thread span rings and their JSON export
+
+  class TraceRecorder
+  {
+  public:
+    static constexpr size_t ringCapacity = 16384;  // spans per thread
+
+    static void record(const char* name, uint64_t startNs, uint64_t endNs);
+    static void nameThread(const std::string& name);
+    static void setEnabled(bool enabled);
+    static bool enabled();
+
+    static size_t writeJson(std::ostream& out);
+    static bool save(const std::string& path);
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // TraceSpan - records its lifetime as a named span
+
+  class TraceSpan
+  {
+  public:
+    explicit TraceSpan(const char* name) : name_(name), start_(SteadyTicks::now()) {}
+    ~TraceSpan() { TraceRecorder::record(name_, start_, SteadyTicks::now()); }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+  private:
+    const char* name_;
+    uint64_t start_;
+  };
+}
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_NAME_(a, b) TRACE_CONCAT_(a, b)
+
+#ifdef TRACE_DISABLED
+#define TRACE_SCOPE(name) ((void)0)
+#else
+#define TRACE_SCOPE(name) Utilities::TraceSpan TRACE_NAME_(traceSpan_, __LINE__)(name)
+#endif